@@ -3,17 +3,21 @@
  *
  * Evaluation : not very logical choice of Posit usage, but still impressive
  * - 1323 bytes of memory is going to be difficult on UNO, from a 2048 total
- * - makes use of intermediate float for epsilon greedy decision
+ * - epsilon greedy decision now uses PositRandom.h, without float
+ * - SARSA update and greedy action use PositRL.h, one truncation per update
  * - makes use of many 16-bit ints and floats 
  * - modified by ChatGPT to adapt reward to the car's speed at the goal position
  ****************************************************************************/
 #include "Posit.h"  // Include your Posit library
+#include "PositRandom.h"
+#include "PositRL.h"
 
 // Hyperparameters
-Posit8 alpha = Posit8(0.1);  // Learning rate
-Posit8 gamma = Posit8(0.9);  // Discount factor
+positTD td(posit16_t(0.1), posit16_t(0.9), 3);  // Learning rate, discount factor, actions per state
 Posit8 epsilon = Posit8(0.1); // Exploration rate
 
+positRandom rng;  // Posit random generator, seeded in setup()
+
 // State and action space
 Posit8 Q_table[21][21][3];   // Q-values table for position, velocity, and actions
 int actions[3] = {-1, 0, 1};  // Action values: reverse, neutral, forward
@@ -27,22 +31,18 @@ Posit8 velocity_max = Posit8(0.07);
 // Initialize state variables
 Posit8 position, velocity;
 
+// Index of a state in the Q-table seen as a contiguous array of 21 * 21 * 3 values
+uint16_t stateIndex(Posit8 pos, Posit8 vel) {
+    return (int)(pos.to_float() * 10 + 10) * 21 + (int)(vel.to_float() * 10 + 10);
+}
+
 // Helper function to get a random action with epsilon-greedy
 int getAction(Posit8 pos, Posit8 vel) {
-    if (random(100) < (epsilon.to_float() * 100)) {
+    if (rng.bernoulli(epsilon)) {  // true with probability epsilon, no float
         return actions[random(3)];  // Explore
     }
     // Exploit: choose the action with max Q-value for given state
-    int best_action = 0;
-    Posit8 max_q = Q_table[(int)(pos.to_float() * 10 + 10)][(int)(vel.to_float() * 10 + 10)][0];
-    for (int a = 1; a < 3; a++) {
-        Posit8 q_value = Q_table[(int)(pos.to_float() * 10 + 10)][(int)(vel.to_float() * 10 + 10)][a];
-        if (q_value > max_q) {
-            max_q = q_value;
-            best_action = a;
-        }
-    }
-    return actions[best_action];
+    return actions[td.greedy(&Q_table[0][0][0], stateIndex(pos, vel))];
 }
 
 // Update state based on action
@@ -66,14 +66,9 @@ Posit8 getReward() {
 
 // SARSA Q-table update function
 void updateQTable(Posit8 pos, Posit8 vel, int action, Posit8 reward, Posit8 next_pos, Posit8 next_vel, int next_action) {
-    int pos_index = (int)(pos.to_float() * 10 + 10);
-    int vel_index = (int)(vel.to_float() * 10 + 10);
-    int action_index = (action + 1);  // Convert -1, 0, 1 to 0, 1, 2
-
-    Posit8 current_q = Q_table[pos_index][vel_index][action_index];
-    Posit8 next_q = Q_table[(int)(next_pos.to_float() * 10 + 10)][(int)(next_vel.to_float() * 10 + 10)][next_action + 1];
-
-    Q_table[pos_index][vel_index][action_index] += alpha * (reward + gamma * next_q - current_q);
+    // Convert actions -1, 0, 1 to 0, 1, 2
+    positTransition t = {stateIndex(pos, vel), (uint8_t)(action + 1), (uint8_t)(next_action + 1), stateIndex(next_pos, next_vel), reward, false};
+    td.sarsa(&Q_table[0][0][0], t);  // Q += alpha * (reward + gamma * next_q - Q), truncated once
 }
 
 // Run a single episode
@@ -103,6 +98,7 @@ void runEpisode() {
 void setup() {
     Serial.begin(9600);
     randomSeed(analogRead(0));  // Seed randomness
+    rng = positRandom(random(1, 0x7FFFFFFFL));
     memset(Q_table, 0, sizeof(Q_table));  // Initialize Q-table to zero
 }
 
@@ -0,0 +1,63 @@
+/***********************
+ * Arduino sketch comparing the default build with the float-free build of the library.
+ * Compile once as is, then once with POSIT_NO_FLOAT commented out, and compare the
+ * program size reported by the IDE and the timings printed on Serial.
+ * Results are printed with PositFormat.h, so that the sketch itself never uses floats.
+ */
+
+#define POSIT_NO_FLOAT // comment out to compare with the soft-float build
+#include "Posit.h"
+#include "PositFormat.h"
+
+#define LOOPS 1000 // so that microseconds for all loops are nanoseconds per operation
+
+volatile uint16_t sink; // keeps the compiler from removing the loops
+
+void printResult(const char* name, unsigned long start, posit16_t last) { // posit8_t is cast
+  unsigned long elapsed = micros() - start;
+  char text[POSIT_CHARS_MAX];
+  char* end = posit_to_chars(text, text + sizeof(text) - 1, last);
+  *end = 0;
+  Serial.print(name);
+  Serial.print(elapsed);
+  Serial.print(" ns/op, last result ");
+  Serial.println(text);
+}
+
+void setup() {
+  Serial.begin(9600);
+#ifdef POSIT_NO_FLOAT
+  Serial.println("Posit library without float\n");
+#else
+  Serial.println("Posit library with float\n");
+#endif
+}
+
+void loop() {
+  posit16_t a(3), b(7), result;
+  posit8_t c(5), d(-3), result8;
+  unsigned long start;
+
+  start = micros();
+  for (int i = 1; i <= LOOPS; i++) sink = (result = posit16_t(i)).value;
+  printResult("posit16_t(int) : ", start, result);
+
+  start = micros();
+  for (int i = 1; i <= LOOPS; i++) sink = (result8 = posit8_t(i)).value;
+  printResult("posit8_t(int) : ", start, result8);
+
+  start = micros();
+  for (int i = 1; i <= LOOPS; i++) sink = (result = a / b).value;
+  printResult("posit16 divide : ", start, result);
+
+  start = micros();
+  for (int i = 1; i <= LOOPS; i++) sink = (result8 = c / d).value;
+  printResult("posit8 divide : ", start, result8);
+
+  start = micros();
+  for (int i = 1; i <= LOOPS; i++) sink = (result = posit16_sqrt(a)).value;
+  printResult("posit16 sqrt : ", start, result);
+
+  Serial.println();
+  delay(5000);
+}
@@ -11,6 +11,16 @@
 #define ASSERT_EPSILON 0.001  // Allowed error margin
 
 #include "Posit.h"
+#include "PositFormat.h"
+#include "PositStream.h"
+#include "PositExpr.h"
+#include "PositRandom.h"
+#include "PositActivation.h"
+#include "PositRL.h"
+#include "PositDSP.h"
+#ifndef __AVR__ // posit32_t is meant for 32-bit boards
+#include "Posit32.h"
+#endif
 
 // ======================
 // Test Utilities
@@ -106,6 +116,19 @@ void testPosit16Precision() {
   assertNear("PI * e", posit2float(c), 8.53973422f, 0.01f);
 }
 
+void testPosit16Addition() {
+  printTestHeader("Posit16 Addition");
+
+  posit16_t a(1.75f), b(1.5f), c(-1.4375f), tiny((uint16_t)1); // tiny is minpos
+
+  assertNear("carry 1.75 + 1.5", posit2float(a + b), 3.25f, 0.0f);
+  assertNear("cancellation 1.5 - 1.4375", posit2float(b + c), 0.0625f, 0.0f);
+  assertNear("exact cancellation", posit2float(a - a), 0.0f, 0.0f);
+  assertNear("negative result", posit2float(c - a), -3.1875f, 0.0f);
+  assertNear("minpos + 376.5", posit2float(tiny + posit16_t(376.5f)), 376.5f, 0.0f);
+  assertNear("-376.5 - minpos", posit2float(posit16_t(-376.5f) - tiny), -376.5f, 0.0f);
+}
+
 void testTrigonometricFunctions() {
   printTestHeader("Trigonometric Functions");
   
@@ -130,6 +153,343 @@ void testRounding() {
   assertNear("Almost one", posit2float(almost_one), 1.0f, 0.1f);
 }
 
+void testMixedPrecision() {
+  printTestHeader("Mixed Posit16/Posit8 Operations");
+
+  posit16_t acc(1.5f);
+  posit8_t w(0.75f), x(-2.0f);
+
+  assertNear("p16 + p8", posit2float(acc + w), 2.25f);
+  assertNear("p8 - p16", posit2float(w - acc), -0.75f);
+  assertNear("p16 * p8", posit2float(acc * x), -3.0f);
+  assertNear("p16 / p8", posit2float(acc / w), 2.0f);
+  assertNear("p8 x p8 -> p16", posit2float(posit16_t::posit16_mul(w, x)), -1.5f);
+
+  acc = posit16_t::posit16_fma(acc, w, x); // 1.5 + 0.75 * -2
+  assertNear("fma p16 + p8*p8", posit2float(acc), 0.0f);
+
+  posit8_t weights[3] = {posit8_t(0.5f), posit8_t(0.25f), posit8_t(-1.0f)};
+  posit8_t inputs[3] = {posit8_t(3.0f), posit8_t(6.0f), posit8_t(0.5f)};
+  assertNear("dot p8 -> p16", posit2float(posit16_dot(weights, inputs, 3)), 2.5f);
+}
+
+void assertText(const char* msg, const char* actual, const char* actualEnd, const char* expected) {
+  testCount++;
+  if (actualEnd && (size_t)(actualEnd - actual) == strlen(expected) && !strncmp(actual, expected, actualEnd - actual)) return;
+  failCount++;
+  Serial.print("FAIL: ");
+  Serial.print(msg);
+  Serial.print(" | Expected: ");
+  Serial.println(expected);
+}
+
+void testDecimalFormatting() {
+  printTestHeader("Decimal Formatting and Parsing");
+
+  char buffer[POSIT_CHARS_MAX];
+  char* end = posit_to_chars(buffer, buffer + sizeof(buffer), posit16_t(0.1f));
+  assertText("to_chars 0.1", buffer, end, "0.1");
+  end = posit_to_chars(buffer, buffer + sizeof(buffer), posit16_t(-1.5f));
+  assertText("to_chars -1.5", buffer, end, "-1.5");
+  end = posit_to_chars(buffer, buffer + sizeof(buffer), posit16_t((uint16_t)0x8000));
+  assertText("to_chars NaR", buffer, end, "NaR");
+  end = posit_to_chars(buffer, buffer + 2, posit16_t(-1.5f));
+  assertNear("to_chars buffer too small", (float)(end == NULL), 1.0f, 0.0f);
+
+  const char text[] = "3.14159";
+  posit16_t parsed((uint16_t)0);
+  posit_from_chars(text, text + 7, parsed);
+  assertNear("from_chars 3.14159", (float)parsed.value, (float)posit16_t(3.14159f).value, 0.0f);
+
+  uint16_t roundTrips = 0; // all posit8 values read back unchanged
+  for (uint16_t raw = 0; raw < 256; raw++) {
+    posit8_t p((uint8_t)raw), q((uint8_t)0);
+    end = posit_to_chars(buffer, buffer + sizeof(buffer), p);
+    posit_from_chars(buffer, end, q);
+    if (q.value == p.value) roundTrips++;
+  }
+  assertNear("posit8 round trips", (float)roundTrips, 256.0f, 0.0f);
+
+  posit16_t values[3] = {posit16_t(1.5f), posit16_t(-2.0f), posit16_t(0.25f)};
+  char line[32];
+  end = posit_to_line(line, line + sizeof(line), values, 3);
+  assertText("to_line", line, end, "1.5,-2,0.25\n");
+  posit16_t readBack[3] = {posit16_t((uint16_t)0), posit16_t((uint16_t)0), posit16_t((uint16_t)0)};
+  assertNear("from_line count", (float)posit_from_line(line, end, readBack, 3), 3.0f, 0.0f);
+  assertNear("from_line value", posit2float(readBack[2]), 0.25f);
+}
+
+void testSparseStream() {
+  printTestHeader("Sparse Array Streaming");
+
+  posit8_t table[200];
+  for (uint8_t i = 0; i < 200; i++) table[i] = posit8_t((uint8_t)0);
+  table[3] = posit8_t(0.5f);
+  table[4] = posit8_t(0.55f);
+  table[150] = posit8_t(-3.0f);
+
+  positStreamEncoder encoder;
+  uint8_t stream[32];
+  uint16_t length = encoder.encode(table, 200, stream, sizeof(stream));
+  length += encoder.end(stream + length);
+  assertNear("encoded all values", (float)encoder.consumed, 200.0f, 0.0f);
+  assertNear("compressed size", (float)(length <= 12), 1.0f, 0.0f); // 200 bytes raw
+
+  posit8_t copy[200];
+  positStreamDecoder decoder;
+  uint16_t count = 0, used = 0;
+  while (used < length) { // small chunks, like bytes from Serial
+    uint16_t chunk = length - used < 3 ? length - used : 3;
+    count += decoder.decode(stream + used, chunk, copy + count, 200 - count);
+    used += decoder.consumed;
+    if (!decoder.consumed) break;
+  }
+  uint8_t same = count == 200;
+  for (uint8_t i = 0; i < 200 && same; i++) same = copy[i].value == table[i].value;
+  assertNear("decoded table", (float)same, 1.0f, 0.0f);
+  assertNear("end of stream", (float)decoder.ended, 1.0f, 0.0f);
+}
+
+void testFloatFreeConversions() { // same results with or without POSIT_NO_FLOAT
+  printTestHeader("Float-free Conversions");
+
+  uint8_t same = 1;
+  for (int i = -300; i <= 300 && same; i++) {
+    same = posit16_t(i).value == posit16_t((float)i).value && posit8_t(i).value == posit8_t((float)i).value;
+  }
+  assertNear("int == float constructors", (float)same, 1.0f, 0.0f);
+  assertNear("p16 from large int", posit2float(posit16_t(30000)), 30000.0f, 512.0f);
+  assertNear("p16 from double", posit2float(posit16_t(-0.375)), -0.375f);
+  assertNear("p16 1/3", posit2float(posit16_t(1) / posit16_t(3)), 0.33333f);
+  assertNear("p8 -7/2", posit2float(posit8_t(-7) / posit8_t(2)), -3.5f);
+  posit8_t quarter(0.25f);
+  assertNear("p8 sqrt(0.25)", posit2float(posit8_t::posit8_sqrt(quarter)), 0.5f);
+  assertNear("negative to float", posit2float(posit16_t(-2.5f)), -2.5f, 0.0f);
+}
+
+void testLiterals() {
+  printTestHeader("Literals and Constants");
+
+#ifdef POSIT_BIT_CAST // constexpr float constructors, values computed by the compiler
+  constexpr posit16_t pi = 3.14159265_p16;
+  static_assert(pi.value == 0x4C90, "pi is a compile-time bit pattern");
+#else
+  posit16_t pi = 3.14159265_p16;
+#endif
+  assertNear("3.14159265_p16", posit2float(pi), 3.1416f, 0.002f);
+  assertNear("_p16 == float constructor", (float)(pi.value == posit16_t(3.14159265f).value), 1.0f, 0.0f);
+  assertNear("-2_p8", posit2float(-2_p8), -2.0f, 0.0f);
+  assertNear("0.25_p8", posit2float(0.25_p8), 0.25f, 0.0f);
+  assertNear("100000_p16", posit2float(100000_p16), 99840.0f, 0.0f); // truncated
+  assertNear("negate NaR", (float)((-posit16_t((uint16_t)0x8000)).value == 0x8000), 1.0f, 0.0f);
+}
+
+void testFusedExpressions() {
+  printTestHeader("Fused Expressions");
+
+  posit16_t x(0.5f);
+  posit16_t s = posit_fused(x) / 3 * (3 - posit_fused(x) * x / 2); // x - x^3/6, one rounding
+  assertNear("fused sin(0.5) formula", posit2float(s), 0.47917f, 0.0002f);
+  posit16_t third = posit_fused(posit16_t(1)) / 3;
+  assertNear("fused 1/3 == plain 1/3", (float)(third.value == (posit16_t(1) / posit16_t(3)).value), 1.0f, 0.0f);
+
+  posit8_t q(0.5f), alpha(0.125f), reward(0.0f), gamma(0.9375f), next(0.25f);
+  posit8_t updated = posit_fused(q) + posit_fused(alpha) * (posit_fused(reward) + posit_fused(gamma) * next - q); // TD update
+  // exact 0.466796875, truncated once (the operator chain gives 0.46875)
+  assertNear("fused posit8 update", posit2float(updated), ES8 == 2 ? 0.4375f : 0.453125f, 0.0f);
+  posit16_t leaf = posit_fused(x); // a lone leaf converts too
+  assertNear("fused leaf", posit2float(leaf), 0.5f, 0.0f);
+  posit16_t mixed = posit_fused(posit16_t(1000)) * q + 3000; // posit16_t, posit8_t and int
+  assertNear("fused mixed operands", posit2float(mixed), 3500.0f, 0.0f);
+  posit16_t negated = -(posit_fused(x) * 2);
+  assertNear("fused negation", posit2float(negated), -1.0f, 0.0f);
+  posit16_t nar = posit_fused(x) / 0;
+  assertNear("fused x/0 is NaR", (float)(nar.value == 0x8000), 1.0f, 0.0f);
+}
+
+void testSplitPosit() {
+  printTestHeader("Unpacked Posits");
+
+  uint8_t same = 1;
+  for (uint16_t i = 0; i < 256 && same; i++) { // pack(unpack(p)) == p
+    posit8_t p8((uint8_t) i);
+    posit16_t p16((uint16_t) (i * 257));
+    same = splitPosit::unpack(p8).pack8().value == p8.value && splitPosit::unpack(p16).pack16().value == p16.value;
+  }
+  assertNear("unpack/pack round trip", (float)same, 1.0f, 0.0f);
+
+  posit16_t two(2);
+  splitPosit x = splitPosit::unpack(two), half = posit16_t(0.5f);
+  for (uint8_t i = 0; i < 6; i++) x = (x + two / x) * half; // Newton loop for sqrt(2), stays unpacked
+  assertNear("Newton sqrt(2)", posit2float(x.pack16()), 1.41421f, 0.0005f);
+
+  splitPosit sum, tenth = posit16_t(1) / posit16_t(10);
+  posit16_t plainSum(0);
+  for (uint8_t i = 0; i < 100; i++) {
+    sum += tenth;
+    plainSum += posit16_t(1) / posit16_t(10);
+  }
+  assertNear("unpacked sum of 0.1", posit2float(sum.pack16()), 10.0f, 0.01f);
+  assertNear("unpacked sum more accurate", (float)(abs(posit2float(sum.pack16()) - 10.0f) <= abs(posit2float(plainSum) - 10.0f)), 1.0f, 0.0f);
+  assertNear("unpacked posit8 result", posit2float((splitPosit(3) / 4).pack8()), 0.75f, 0.0f);
+  assertNear("compare", (float)(splitPosit(-3) < splitPosit::unpack(posit8_t(0.5f)) && -splitPosit(0) == 0), 1.0f, 0.0f);
+  assertNear("NaR below numbers", (float)(splitPosit::NaR() < splitPosit(-1000)), 1.0f, 0.0f);
+}
+
+void testRandom() {
+  printTestHeader("Random Posits");
+
+  positRandom rng(2024);
+  posit16_t values[64];
+  rng.fill(values, 64);
+  uint8_t inRange = 1;
+  for (uint8_t i = 0; i < 64; i++) inRange &= values[i].value < 0x4000; // [0,1) : below raw 1.0
+  assertNear("uniform16 in [0,1)", (float)inRange, 1.0f, 0.0f);
+
+  uint16_t hits16 = 0, hits8 = 0, below8 = 0;
+  for (uint16_t i = 0; i < 4000; i++) {
+    hits16 += rng.bernoulli(posit16_t(0.25f));
+    hits8 += rng.bernoulli(posit8_t(0.5f));
+    below8 += rng.uniform8().value < posit8_t(0.5f).value;
+  }
+  assertNear("bernoulli(0.25) p16", hits16 / 4000.0f, 0.25f, 0.03f);
+  assertNear("bernoulli(0.5) p8", hits8 / 4000.0f, 0.5f, 0.03f);
+  assertNear("uniform8 median", below8 / 4000.0f, 0.5f, 0.03f);
+  assertNear("bernoulli(1) always", (float)(rng.bernoulli(posit8_t(1)) && !rng.bernoulli(posit16_t((uint16_t)0))), 1.0f, 0.0f);
+}
+
+void testFixedPoint() {
+  printTestHeader("Q1.6 Fixed Point");
+
+  assertNear("q6 32 is 0.5", posit2float(posit8_from_q6(32)), 0.5f, 0.0f);
+  assertNear("q6 -80 is -1.25", posit2float(posit8_from_q6(-80)), -1.25f, 0.0f);
+  assertNear("0.75 is q6 48", (float) posit8_to_q6(posit8_t(0.75f)), 48.0f, 0.0f);
+  assertNear("q6 saturates", (float) posit8_to_q6(posit8_t(3)), 127.0f, 0.0f);
+  int8_t q[3] = {-64, 16, 1};
+  posit8_t p[3];
+  posit8_from_q6(q, p, 3);
+  posit8_to_q6(p, q, 3);
+  assertNear("q6 bulk round trip", (float)(q[0] == -64 && q[1] == 16 && q[2] == 1), 1.0f, 0.0f);
+#if ES8 == 0
+  assertNear("q6 same bits", (float)(p[1].value == 16), 1.0f, 0.0f);
+  assertNear("linear add", posit2float(posit8_t(0.75f) + posit8_t(-0.125f)), 0.625f, 0.0f);
+  assertNear("linear mul truncated", posit2float(posit8_t(0.75f) * posit8_t(-0.203125f)), -0.140625f, 0.0f); // -0.15234375
+#endif
+}
+
+void testTemporalDifference() {
+  printTestHeader("TD Updates");
+
+  positTD td(posit16_t(0.5f), posit16_t(0.5f), 2); // alpha, gamma, 2 actions
+  posit8_t q[6] = {posit8_t(0), posit8_t(0), posit8_t(-1), posit8_t(1), posit8_t((uint8_t)0x80), posit8_t(-2)};
+  assertNear("greedy", (float) td.greedy(q, 1), 1.0f, 0.0f);
+  assertNear("greedy skips NaR", (float) td.greedy(q, 2), 1.0f, 0.0f);
+
+  positTransition t = {0, 1, 0, 1, posit16_t(1), false}; // state 0, action 1 -> state 1, action 0
+  td.sarsa(q, t); // 0 + 0.5 * (1 + 0.5 * -1 - 0)
+  assertNear("sarsa", posit2float(q[1]), 0.25f, 0.0f);
+  td.qLearning(q, t); // 0.25 + 0.5 * (1 + 0.5 * 1 - 0.25)
+  assertNear("q-learning", posit2float(q[1]), 0.875f, 0.0f);
+
+  positTransition batch[3] = {{0, 0, 0, 0, posit16_t(1), true}, {1, 0, 0, 0, posit16_t(2), true}, {0, 0, 0, 0, posit16_t(1), true}};
+  td.qLearning(q, batch, 3); // entry 0 twice : 0.5 then 0.75, packed once
+  assertNear("batch same entry", posit2float(q[0]), 0.75f, 0.0f);
+  assertNear("batch other entry", posit2float(q[2]), 0.5f, 0.0f); // -1 + 0.5 * (2 + 1)
+
+  posit16_t v[3] = {posit16_t(0), posit16_t(0), posit16_t(4)};
+  positTransition step = {1, 0, 0, 2, posit16_t(0), false};
+  positTD(posit16_t(0.5f), posit16_t(0.75f)).td0(v, step); // 0 + 0.5 * (0.75 * 4)
+  assertNear("td0", posit2float(v[1]), 1.5f, 0.0f);
+}
+
+void testActivations() {
+  printTestHeader("Activations");
+
+  assertNear("p16 sigmoid(0)", posit2float(posit16_sigmoid(posit16_t(0))), 0.5f, 0.0f);
+  assertNear("p16 sigmoid(2)", posit2float(posit16_sigmoid(posit16_t(2))), 0.8807971f, 0.0005f);
+  assertNear("p16 sigmoid(-2)", posit2float(posit16_sigmoid(posit16_t(-2))), 0.1192029f, 0.0005f);
+  assertNear("p16 tanh(0.5)", posit2float(posit16_tanh(posit16_t(0.5f))), 0.4621172f, 0.0005f);
+  assertNear("p16 tanh(-3)", posit2float(posit16_tanh(posit16_t(-3))), -0.9950548f, 0.0005f);
+  assertNear("p16 tanh(x) truncates below x near 0", (float)(posit16_tanh(posit16_t(0.001f)).value == (uint16_t)(posit16_t(0.001f).value - 1)), 1.0f, 0.0f);
+  assertNear("p16 tanh(-x) truncates above -x near 0", (float)(posit16_tanh(posit16_t(-0.001f)).value == (uint16_t)(posit16_t(-0.001f).value + 1)), 1.0f, 0.0f);
+  assertNear("p16 tanh(0)", (float)posit16_tanh(posit16_t((uint16_t)0)).value, 0.0f, 0.0f);
+  assertNear("p8 sigmoid(1)", posit2float(posit8_sigmoid(posit8_t(1))), 0.7310586f, 0.07f);
+  assertNear("p8 tanh(-1)", posit2float(posit8_tanh(posit8_t(-1))), -0.7615942f, 0.13f);
+  assertNear("p16 relu(-2)", posit2float(posit16_relu(posit16_t(-2))), 0.0f, 0.0f);
+  assertNear("p16 hard_swish(1.5)", posit2float(posit16_hard_swish(posit16_t(1.5f))), 1.125f, 0.0f); // exact
+  assertNear("p8 hard_swish(-1)", posit2float(posit8_hard_swish(posit8_t(-1))), -0.3333333f, 0.04f);
+  assertNear("p8 hard_swish(-4)", posit2float(posit8_hard_swish(posit8_t(-4))), 0.0f, 0.0f);
+  assertNear("sigmoid(NaR) is NaR", (float)(posit16_sigmoid(posit16_t((uint16_t)0x8000)).value == 0x8000), 1.0f, 0.0f);
+
+  posit8_t layer[4] = {posit8_t(-2), posit8_t(0), posit8_t(1), posit8_t((uint8_t)0x80)};
+  posit8_relu(layer, layer, 4); // bulk, in place
+  assertNear("p8 bulk relu", (float)(layer[0].value == 0 && layer[2].value == posit8_t(1).value && layer[3].value == 0x80), 1.0f, 0.0f);
+}
+
+void testDSP() {
+  printTestHeader("DSP");
+
+  positAccumulator sum;
+  sum.add(posit16_t(1));
+  for (uint8_t i = 0; i < 16; i++) sum.add(posit16_t(1), posit16_t(1.0f / 4096)); // each one lost in 1 + 2^-12
+  assertNear("accumulator keeps small terms", posit2float(sum.pack16()), 1.00390625f, 0.0f);
+
+  const posit16_t taps[3] = {posit16_t(0.5f), posit16_t(-0.25f), posit16_t(3)};
+  posit16_t delay[3], response[4];
+  const posit16_t impulse[4] = {posit16_t(1), posit16_t(0), posit16_t(0), posit16_t(0)};
+  positFIR fir(taps, delay, 3);
+  fir.filter(impulse, response, 4);
+  assertNear("FIR impulse response", (float)(response[0].value == taps[0].value && response[1].value == taps[1].value
+    && response[2].value == taps[2].value && response[3].value == 0), 1.0f, 0.0f);
+
+  posit16_t re[8], im[8];
+  int32_t work[16];
+  for (uint8_t i = 0; i < 8; i++) re[i] = im[i] = posit16_t(0);
+  re[1] = posit16_t(1); // x = delta(n - 1), X[k] = exp(-2 i pi k / 8)
+  posit16_fft(re, im, 8, work);
+  assertNear("FFT delay re[1]", posit2float(re[1]), 0.7071068f, 0.0005f);
+  assertNear("FFT delay im[2]", posit2float(im[2]), -1.0f, 0.0f);
+  assertNear("FFT delay re[4]", posit2float(re[4]), -1.0f, 0.0f);
+  posit16_fft(re, im, 8, work, true);
+  assertNear("inverse FFT", posit2float(re[1]), 1.0f, 0.0005f);
+  assertNear("inverse FFT zero", posit2float(re[5]), 0.0f, 0.0005f);
+
+  for (uint8_t i = 0; i < 8; i++) re[i] = posit16_t(2);
+  re[3] = posit16_t((uint16_t)0x8000);
+  posit16_fft(re, im, 8, work);
+  assertNear("FFT of NaR is NaR", (float)(re[0].value == 0x8000 && im[7].value == 0x8000), 1.0f, 0.0f);
+}
+
+#ifndef __AVR__
+void testPosit32() {
+  printTestHeader("Posit32");
+
+  posit32_t third = posit32_t(1) / posit32_t(3);
+  assertNear("p32 1/3", posit2float(third), 0.33333333f, 0.0000001f);
+  assertNear("p32 1/3 bits", (float)(third.value == 0x32AAAAAAUL), 1.0f, 0.0f); // truncated
+  assertNear("p32 add", posit2float(posit32_t(1.5f) + posit32_t(-0.25f)), 1.25f, 0.0f);
+  assertNear("p32 mul", posit2float(posit32_t(-3) * posit32_t(0.5f)), -1.5f, 0.0f);
+  assertNear("p32 sqrt(2)", posit2float(posit32_sqrt(posit32_t(2))), 1.4142135f, 0.0000002f);
+  assertNear("p32 sqrt(-1) is NaR", (float)(posit32_sqrt(posit32_t(-1)).value == 0x80000000UL), 1.0f, 0.0f);
+  assertNear("p32 x/0 is NaR", (float)((third / 0).value == 0x80000000UL), 1.0f, 0.0f);
+  assertNear("p32 1e38 saturates", (float)(posit32_t(1e38f).value == 0x7FFFFFFFUL), 1.0f, 0.0f);
+
+  uint8_t same = 1;
+  for (uint32_t i = 0; i < 0x10000UL && same; i += 13) { // posit16 -> posit32 -> posit16 is exact
+    same = posit32_t(posit16_t((uint16_t) i)).to16().value == i;
+  }
+  assertNear("p16 round trip", (float)same, 1.0f, 0.0f);
+  assertNear("p32 to p16 truncates", posit2float(third.to16()), posit2float(posit16_t(1) / posit16_t(3)), 0.0f);
+  assertNear("p32 to p8 1", (float)(posit32_t(1.0f).to8().value == posit8_t(1.0f).value), 1.0f, 0.0f);
+  assertNear("p32 to p8 1.5", (float)(posit32_t(1.5f).to8().value == posit8_t(1.5f).value), 1.0f, 0.0f);
+  assertNear("p32 to p8 100", (float)(posit32_t(100.0f).to8().value == posit8_t(100.0f).value), 1.0f, 0.0f);
+  assertNear("p16 * p32", posit2float(posit16_t(3) * posit32_t(0.5f)), 1.5f, 0.0f);
+  assertNear("p32 compare", (float)(posit32_t(-2) < third && third < posit32_t(1) && third == third), 1.0f, 0.0f);
+  assertNear("NaR below numbers", (float)(posit32_t((uint32_t)0x80000000UL) < posit32_t(-1000)), 1.0f, 0.0f);
+  assertNear("_p32 literal", (float)(3.14159265_p32 == posit32_t(3.14159265)), 1.0f, 0.0f);
+}
+#endif
+
 // ======================
 // Main Program
 // ======================
@@ -143,8 +503,24 @@ void setup() {
   testPosit8Basic();
   testPosit8EdgeCases();
   testPosit16Precision();
+  testPosit16Addition();
   testTrigonometricFunctions();
   testRounding();
+  testMixedPrecision();
+  testDecimalFormatting();
+  testSparseStream();
+  testFloatFreeConversions();
+  testLiterals();
+  testFusedExpressions();
+  testSplitPosit();
+  testRandom();
+  testFixedPoint();
+  testActivations();
+  testTemporalDifference();
+  testDSP();
+#ifndef __AVR__
+  testPosit32();
+#endif
 
   // Print summary
   Serial.println("\n=== Test Summary ===");
@@ -0,0 +1,75 @@
+/*************************************************************************************
+  Generator of the tables in PositActivation.h : sigmoid and tanh of every posit8
+  (ES8 = 1 and 2, ES8 = 0 uses bit tricks instead), truncated toward zero like posit
+  operations, and fixed-point values (2^32 is one) of sigmoid(-x) and tanh(x) at 257
+  positive posit16 points for interpolation. Built with POSIT_NO_FLOAT so that posits
+  are made from all 52 bits of double results.
+
+  Build and run from this directory, once for each ES8 value :
+    g++ -O2 -DES8=2 -I. -I../../src ActivationTables.cpp -o ActivationTables && ./ActivationTables
+************************************************************************************/
+
+#define POSIT_NO_FLOAT
+#include "Arduino.h"
+#include "Posit.h"
+
+static double value16(uint16_t raw) { // exact, posit2float() truncates nothing but use parts
+  bool sign;
+  int8_t powerof2;
+  uint16_t mantissa;
+  if (raw == 0) return 0;
+  posit16_t::positSplit(posit16_t(raw), sign, powerof2, mantissa);
+  return (sign ? -1 : 1) * ldexp(mantissa, powerof2 - 15);
+}
+
+static double value8(uint8_t raw) {
+  bool sign;
+  int8_t powerof2;
+  uint8_t mantissa;
+  if (raw == 0) return 0;
+  posit8_t::positSplit(posit8_t(raw), sign, powerof2, mantissa);
+  return (sign ? -1 : 1) * ldexp(mantissa, powerof2 - 7);
+}
+
+static double sigmoidTail(double x) { // sigmoid(-x), keeps its relative precision for big x
+  return 1 / (1 + exp(x));
+}
+
+static double sigmoid(double x) { // each side from the tail that does not cancel
+  return x >= 0 ? 1 - sigmoidTail(x) : sigmoidTail(-x);
+}
+
+static void table8(const char* name, double (*function)(double)) {
+  printf("static const uint8_t %s[256] PROGMEM = { // ES8 = %d, indexed by raw value\n", name, ES8);
+  for (uint16_t raw = 0; raw < 256; raw++) {
+    double y = function(value8(raw));
+    uint8_t result = raw == 0x80 ? 0x80 : posit8_t(y).value; // NaR stays NaR
+    // sigmoid and tanh stay strictly inside (-1,1) : a double result rounded to +-1
+    // truncates to the next posit toward zero
+    if (y >= 1) result--;
+    if (y <= -1) result++;
+    printf("%s0x%02X%s", raw % 16 ? " " : "  ", result, raw == 255 ? "\n" : raw % 16 == 15 ? ",\n" : ",");
+  }
+  printf("};\n");
+}
+
+static void table16(const char* name, double (*function)(double)) {
+  printf("static const uint32_t %s[257] PROGMEM = { // x = index << 7 as raw value\n", name);
+  for (uint16_t index = 0; index <= 256; index++) {
+    double x = index == 256 ? INFINITY : value16(index << 7); // limit at the end
+    double fraction = ldexp(function(x), 32);
+    uint32_t result = fraction >= 4294967295.0 ? 0xFFFFFFFFUL : (uint32_t) fraction;
+    printf("%s0x%08lXUL%s", index % 6 ? " " : "  ", (unsigned long) result, index == 256 ? "\n" : index % 6 == 5 ? ",\n" : ",");
+  }
+  printf("};\n");
+}
+
+int main() {
+  if (ES8) {
+    table8("positSigmoid8Table", sigmoid);
+    table8("positTanh8Table", tanh);
+  }
+  table16("positSigmoid16Table", sigmoidTail);
+  table16("positTanh16Table", tanh);
+  return 0;
+}
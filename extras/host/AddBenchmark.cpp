@@ -0,0 +1,103 @@
+/*************************************************************************************
+  Host benchmark of posit16 addition : 16-bit kernel of the library (addParts)
+  against the previous kernel using 32-bit long mantissas, kept here as reference.
+  Operands are split beforehand, the timings include packing the result.
+
+  Build and run from this directory :
+    g++ -O2 -I. -I../../src AddBenchmark.cpp -o AddBenchmark && ./AddBenchmark
+  Both kernels must give the same results, except that the reference is given the
+  same clamped alignment shift (shifting 16-bit mantissas by 32 or more was undefined).
+************************************************************************************/
+
+#include "Arduino.h"
+#include "Posit.h"
+
+#define PAIRS 4096 // operands fit in L1 cache, so that the kernel is measured
+#define ROUNDS 2000
+
+struct parts { // split operand, as given to addParts by posit16_add
+  bool sign;
+  int8_t exponent;
+  uint16_t mantissa;
+};
+
+static posit16_t longAddParts(bool aSign, int8_t aExponent, uint16_t aMantissa,
+                              bool bSign, int8_t bExponent, uint16_t bMantissa) { // previous kernel
+  bool tempSign = 0;
+  int8_t tempExponent;
+  uint16_t tempMantissa;
+
+  if (aExponent > bExponent) bMantissa = (aExponent - bExponent < 16) ? bMantissa >> (aExponent - bExponent) : 0;
+  if (aExponent < bExponent) aMantissa = (bExponent - aExponent < 16) ? aMantissa >> (bExponent - aExponent) : 0;
+  tempExponent = max(aExponent, bExponent);
+  long longMantissa = (long) aMantissa + bMantissa;
+  if (aSign) longMantissa -= 2L * aMantissa;
+  if (bSign) longMantissa -= 2L * bMantissa;
+  if (longMantissa < 0) {
+    tempSign = 1;
+    longMantissa = -longMantissa;
+  }
+  if (longMantissa == 0) return posit16_t((uint16_t) 0);
+  if (longMantissa > 0xFFFFL) tempExponent++;
+  else longMantissa <<= 1;
+  while (longMantissa < 65536L) {
+    tempExponent--;
+    longMantissa <<= 1;
+  }
+  tempMantissa = longMantissa;
+  return posit16_t(tempSign, tempExponent, tempMantissa);
+}
+
+static uint16_t randomRaw(uint32_t& seed, uint16_t spread) { // xorshift, values around +-1
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  uint16_t raw = 0x4000 - spread / 2 + seed % spread; // 0x4000 is 1.0
+  return (seed & 0x10000UL) ? -raw : raw;
+}
+
+static void benchmark(const char* name, uint16_t spread) {
+  static parts a[PAIRS], b[PAIRS];
+  uint32_t seed = 12345;
+  for (uint16_t i = 0; i < PAIRS; i++) { // split once, so that only the kernels are timed
+    posit16_t::positSplit(posit16_t(randomRaw(seed, spread)), a[i].sign, a[i].exponent, a[i].mantissa);
+    posit16_t::positSplit(posit16_t(randomRaw(seed, spread)), b[i].sign, b[i].exponent, b[i].mantissa);
+  }
+
+  uint32_t mismatches = 0;
+  for (uint16_t i = 0; i < PAIRS; i++) {
+    mismatches += posit16_t::addParts(a[i].sign, a[i].exponent, a[i].mantissa, b[i].sign, b[i].exponent, b[i].mantissa).value
+               != longAddParts(a[i].sign, a[i].exponent, a[i].mantissa, b[i].sign, b[i].exponent, b[i].mantissa).value;
+  }
+
+  volatile uint16_t sink = 0;
+  unsigned long start = micros();
+  for (uint16_t round = 0; round < ROUNDS; round++) {
+    uint16_t sum = 0;
+    for (uint16_t i = 0; i < PAIRS; i++) {
+      sum += posit16_t::addParts(a[i].sign, a[i].exponent, a[i].mantissa, b[i].sign, b[i].exponent, b[i].mantissa).value;
+    }
+    sink = sink + sum;
+  }
+  unsigned long kernel16 = micros() - start;
+  start = micros();
+  for (uint16_t round = 0; round < ROUNDS; round++) {
+    uint16_t sum = 0;
+    for (uint16_t i = 0; i < PAIRS; i++) {
+      sum += longAddParts(a[i].sign, a[i].exponent, a[i].mantissa, b[i].sign, b[i].exponent, b[i].mantissa).value;
+    }
+    sink = sink + sum;
+  }
+  unsigned long kernel32 = micros() - start;
+
+  printf("%-28s 16-bit %6.2f ns/op   32-bit %6.2f ns/op   mismatches %lu\n", name,
+         1000.0 * kernel16 / ((double) PAIRS * ROUNDS), 1000.0 * kernel32 / ((double) PAIRS * ROUNDS),
+         (unsigned long) mismatches);
+}
+
+int main() {
+  benchmark("close magnitudes (filters)", 0x0800);
+  benchmark("spread magnitudes", 0x4000);
+  benchmark("whole range", 0x7FFE);
+  return 0;
+}
@@ -0,0 +1,57 @@
+/*************************************************************************************
+  Minimal Arduino.h replacement to compile the library and host tools on a PC,
+  for example with : g++ -O2 -I. -I../../src AddBenchmark.cpp -o AddBenchmark
+  Only what the library and the host tools use : Serial printing, max/min, byte, micros,
+  PROGMEM tables (plain memory on a PC).
+************************************************************************************/
+
+#ifndef ARDUINO_HOST_H
+#define ARDUINO_HOST_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <algorithm>
+
+using std::max;
+using std::min;
+typedef uint8_t byte;
+
+#define PROGMEM
+#define pgm_read_byte(address) (*(const uint8_t*)(address))
+#define pgm_read_word(address) (*(const uint16_t*)(address))
+#define pgm_read_dword(address) (*(const uint32_t*)(address))
+
+#define DEC 10
+#define HEX 16
+#define BIN 2
+
+static inline unsigned long micros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+static inline unsigned long millis() {
+  return micros() / 1000;
+}
+static inline void delay(unsigned long) {} // host tools never wait
+
+struct HostSerial { // prints to stdout
+  void begin(long) {}
+  operator bool() const { return true; }
+  void print(const char* text) { fputs(text, stdout); }
+  void print(char c) { putchar(c); }
+  void print(double v, int digits = 2) { printf("%.*f", digits, v); }
+  void print(long v, int base = DEC) { printf(base == HEX ? "%lX" : "%ld", v); }
+  void print(unsigned long v, int base = DEC) { printf(base == HEX ? "%lX" : "%lu", v); }
+  void print(int v, int base = DEC) { print((long) v, base); }
+  void print(unsigned int v, int base = DEC) { print((unsigned long) v, base); }
+  template<typename T> void println(T v) { print(v); putchar('\n'); }
+  template<typename T> void println(T v, int format) { print(v, format); putchar('\n'); }
+  void println() { putchar('\n'); }
+};
+static HostSerial Serial;
+
+#endif // ARDUINO_HOST_H
@@ -0,0 +1,343 @@
+/*************************************************************************************
+  Host performance regression check across library configurations. Regime loops make
+  the cost of an operation depend on the magnitude of its operands, and ES8, EPSILON
+  and POSIT_NO_FLOAT change the code that runs : a slowdown may only show in one
+  configuration and one range of values.
+
+  Build and run from this directory :
+    g++ -O2 -I. -I../../src ConfigBenchmark.cpp -o ConfigBenchmark
+    ./ConfigBenchmark -csv baseline.csv                  (before a change)
+    ./ConfigBenchmark -baseline baseline.csv -threshold 20 -json results.json
+  The driver compiles this same file once per configuration (ES8 0/1/2, EPSILON 0.0 or
+  0.01, float or POSIT_NO_FLOAT conversions, with $CXX or g++), runs each build 5 times
+  (-runs), interleaved, and keeps the best time per operation, for four operand buckets :
+    one      |x| in [1/4, 4)
+    tiny     long regimes near minpos
+    huge     long regimes near maxpos
+    special  half of the operands are zero or NaR, the other half near one
+  Results are printed, and written with -csv and/or -json. With -baseline (a CSV file
+  written before), each time is compared with the baseline, and the exit status is 1
+  if any of them is more than threshold percent (and 3 ns) slower. Baseline times are
+  first scaled by the median ratio of all times, since the speed of the whole machine
+  changes from one session to another (the exit status is also 1 if this median is
+  beyond the threshold). Default threshold is 25 % : host timings are noisy, even as
+  the best of 5 x 25 runs, so configurations with a slower time run 5 more times and a
+  time only counts if it is still slower as the best of both passes. Use more runs and
+  a quiet machine before blaming a change.
+  The library only truncates, so conversions (float arithmetic or IEEE bits only) are
+  the only rounding setting.
+************************************************************************************/
+
+#include "Arduino.h"
+#include "Posit.h"
+
+#define PAIRS 4096 // operands fit in L1 cache, so that the kernels are measured
+#define ROUNDS 8
+#define REPEATS 25 // best of, repeats spread over the whole process against noise
+#define BUCKETS 4
+#define MIN_DIFFERENCE 3.0 // ns, jitter of the fastest lines
+
+#ifdef CONFIG_CHILD // one configuration, prints op,bucket,ns_per_op lines
+
+static const char* bucketNames[BUCKETS] = {"one", "tiny", "huge", "special"};
+
+static uint32_t xorshift(uint32_t& seed) {
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  return seed;
+}
+
+static uint16_t randomRaw16(uint32_t& seed, uint8_t bucket) {
+  uint32_t bits = xorshift(seed);
+  uint16_t raw;
+  if (bucket == 1) raw = 0x0001 + bits % 0x01FF;
+  else if (bucket == 2) raw = 0x7E00 + bits % 0x01FF;
+  else raw = 0x3000 + bits % 0x2000; // 0x3000 is 1/4, 0x5000 is 4
+  if (bucket == 3 && (bits & 0x100000UL)) return (bits & 0x200000UL) ? 0x8000 : 0;
+  return (bits & 0x10000UL) ? -raw : raw;
+}
+
+static uint8_t randomRaw8(uint32_t& seed, uint8_t bucket) {
+  uint32_t bits = xorshift(seed);
+  uint8_t raw;
+  if (bucket == 1) raw = 0x01 + bits % 0x07;
+  else if (bucket == 2) raw = 0x79 + bits % 0x07;
+  else raw = 0x30 + bits % 0x20; // near one whatever ES8
+  if (bucket == 3 && (bits & 0x100000UL)) return (bits & 0x200000UL) ? 0x80 : 0;
+  return (bits & 0x10000UL) ? -raw : raw;
+}
+
+enum { P8_ADD, P8_MUL, P8_DIV, P8_SQRT, P16_ADD, P16_MUL, P16_DIV, P16_SQRT, P8_FROM_FLOAT, P16_FROM_FLOAT, P16_TO_FLOAT, OPS };
+static const char* opNames[OPS] = {"p8_add", "p8_mul", "p8_div", "p8_sqrt", "p16_add", "p16_mul", "p16_div", "p16_sqrt",
+                                   "p8_from_float", "p16_from_float", "p16_to_float"};
+
+struct operands {
+  posit8_t a8[PAIRS], b8[PAIRS];
+  posit16_t a16[PAIRS], b16[PAIRS];
+  float floats[PAIRS];
+};
+static operands buckets[BUCKETS];
+static volatile uint32_t sink;
+
+static uint32_t run(const operands& x, uint8_t op) { // one pass over the operands
+  posit8_t b8;
+  posit16_t b16;
+  uint32_t sum = 0;
+  switch (op) {
+    case P8_ADD: for (uint16_t i = 0; i < PAIRS; i++) sum += (x.a8[i] + x.b8[i]).value; break;
+    case P8_MUL: for (uint16_t i = 0; i < PAIRS; i++) sum += (x.a8[i] * x.b8[i]).value; break;
+    case P8_DIV: for (uint16_t i = 0; i < PAIRS; i++) sum += (x.a8[i] / x.b8[i]).value; break;
+    case P8_SQRT: for (uint16_t i = 0; i < PAIRS; i++) sum += posit8_t::posit8_sqrt(b8 = x.b8[i]).value; break;
+    case P16_ADD: for (uint16_t i = 0; i < PAIRS; i++) sum += (x.a16[i] + x.b16[i]).value; break;
+    case P16_MUL: for (uint16_t i = 0; i < PAIRS; i++) sum += (x.a16[i] * x.b16[i]).value; break;
+    case P16_DIV: for (uint16_t i = 0; i < PAIRS; i++) sum += (x.a16[i] / x.b16[i]).value; break;
+    case P16_SQRT: for (uint16_t i = 0; i < PAIRS; i++) sum += posit16_sqrt(b16 = x.b16[i]).value; break;
+    case P8_FROM_FLOAT: for (uint16_t i = 0; i < PAIRS; i++) sum += posit8_t(x.floats[i]).value; break;
+    case P16_FROM_FLOAT: for (uint16_t i = 0; i < PAIRS; i++) sum += posit16_t(x.floats[i]).value; break;
+    default: for (uint16_t i = 0; i < PAIRS; i++) sum += (uint32_t) posit2float(x.a16[i]);
+  }
+  return sum;
+}
+
+int main() {
+  for (uint8_t bucket = 0; bucket < BUCKETS; bucket++) {
+    operands& x = buckets[bucket];
+    uint32_t seed = 12345;
+    for (uint16_t i = 0; i < PAIRS; i++) {
+      x.a8[i] = posit8_t(randomRaw8(seed, bucket));
+      x.b8[i] = posit8_t(randomRaw8(seed, bucket));
+      x.a16[i] = posit16_t(randomRaw16(seed, bucket));
+      x.b16[i] = posit16_t(randomRaw16(seed, bucket));
+      x.floats[i] = posit2float(x.a16[i]); // NaR gives NAN, EPSILON flushes the tiny ones
+    }
+  }
+  static unsigned long best[BUCKETS][OPS];
+  for (uint8_t repeat = 0; repeat < REPEATS; repeat++) {
+    for (uint8_t bucket = 0; bucket < BUCKETS; bucket++) {
+      for (uint8_t op = 0; op < OPS; op++) {
+        unsigned long start = micros();
+        for (uint16_t round = 0; round < ROUNDS; round++) sink = sink + run(buckets[bucket], op);
+        unsigned long time = micros() - start;
+        if (repeat == 0 || time < best[bucket][op]) best[bucket][op] = time;
+      }
+    }
+  }
+  for (uint8_t bucket = 0; bucket < BUCKETS; bucket++) {
+    for (uint8_t op = 0; op < OPS; op++) {
+      printf("%s,%s,%.3f\n", opNames[op], bucketNames[bucket], 1000.0 * best[bucket][op] / ((double) PAIRS * ROUNDS));
+    }
+  }
+  return 0;
+}
+
+#else // driver : builds and runs the configurations, writes and compares results
+
+#include <string>
+#include <vector>
+
+struct config {
+  uint8_t es8;
+  const char* epsilon;
+  bool noFloat;
+};
+
+static const config configs[] = {
+  {0, "0.0", false}, {1, "0.0", false}, {2, "0.0", false},
+  {0, "0.01", false}, {1, "0.01", false}, {2, "0.01", false},
+  {0, "0.0", true}, {1, "0.0", true}, {2, "0.0", true},
+  {0, "0.01", true}, {1, "0.01", true}, {2, "0.01", true},
+};
+#define CONFIGS (sizeof(configs) / sizeof(configs[0]))
+
+struct result {
+  std::string key; // es8,epsilon,conversions,op,bucket : the CSV line without the time
+  size_t config; // index in configs
+  double ns; // time per operation
+  double baseline; // zero if not in the baseline
+  bool regression;
+};
+
+static std::vector<result> readCsv(const char* path) {
+  std::vector<result> results;
+  FILE* file = fopen(path, "r");
+  if (!file) return results;
+  char line[256];
+  while (fgets(line, sizeof(line), file)) {
+    char* comma = strrchr(line, ',');
+    if (!comma || line[0] == 'e') continue; // header or empty line
+    *comma = 0;
+    result r = {line, 0, atof(comma + 1), 0, false};
+    results.push_back(r);
+  }
+  fclose(file);
+  return results;
+}
+
+static void childName(char* name, size_t size, size_t c) {
+  snprintf(name, size, "./ConfigBenchmarkChild%u", (unsigned) c);
+}
+
+// Machine speed changes from one process to another and over several seconds : each
+// selected configuration runs once per round, and keeps its best time per line over
+// all rounds (also over earlier calls). Returns false if a run failed
+static bool measure(const std::vector<bool>& selected, unsigned runs, std::vector<result>& results) {
+  char name[64], prefix[64], line[128];
+  for (unsigned run = 0; run < runs; run++) {
+    fprintf(stderr, "run %u of %u\n", run + 1, runs);
+    for (size_t c = 0; c < CONFIGS; c++) {
+      if (!selected[c]) continue;
+      const config& cfg = configs[c];
+      snprintf(prefix, sizeof(prefix), "%u,%s,%s", cfg.es8, cfg.epsilon, cfg.noFloat ? "no_float" : "float");
+      childName(name, sizeof(name), c);
+      FILE* child = popen(name, "r");
+      size_t index = 0;
+      while (child && fgets(line, sizeof(line), child)) {
+        char* comma = strrchr(line, ',');
+        if (!comma) continue;
+        *comma = 0;
+        result r = {std::string(prefix) + "," + line, c, atof(comma + 1), 0, false};
+        for (; index < results.size() && results[index].key != r.key; index++) {}
+        if (index == results.size()) results.push_back(r); // first run
+        else results[index].ns = min(results[index].ns, r.ns);
+      }
+      if (!child || pclose(child)) return false;
+    }
+  }
+  return true;
+}
+
+// The whole machine may run faster or slower than when the baseline was measured :
+// times are compared after scaling baselines by the median of all ratios, and the
+// median itself must stay within the threshold. Returns the count of regressions
+static uint32_t compare(std::vector<result>& results, double threshold, double& speed) {
+  std::vector<double> ratios;
+  for (size_t i = 0; i < results.size(); i++) {
+    if (results[i].baseline) ratios.push_back(results[i].ns / results[i].baseline);
+  }
+  std::sort(ratios.begin(), ratios.end());
+  speed = ratios.empty() ? 1 : ratios[ratios.size() / 2];
+  uint32_t slower = 0;
+  for (size_t i = 0; i < results.size(); i++) {
+    result& r = results[i];
+    double expected = r.baseline * speed;
+    r.regression = r.baseline && r.ns > expected * (1 + threshold / 100) && r.ns - expected > MIN_DIFFERENCE;
+    slower += r.regression;
+  }
+  return slower;
+}
+
+int main(int argc, char** argv) {
+  const char* csvPath = NULL;
+  const char* jsonPath = NULL;
+  const char* baselinePath = NULL;
+  double threshold = 25;
+  unsigned runs = 5;
+  bool usage = false;
+  for (int i = 1; i < argc; i += 2) {
+    if (i + 1 == argc) usage = true; // option without its value
+    else if (!strcmp(argv[i], "-csv")) csvPath = argv[i + 1];
+    else if (!strcmp(argv[i], "-json")) jsonPath = argv[i + 1];
+    else if (!strcmp(argv[i], "-baseline")) baselinePath = argv[i + 1];
+    else if (!strcmp(argv[i], "-threshold")) threshold = atof(argv[i + 1]);
+    else if (!strcmp(argv[i], "-runs")) runs = max(1, atoi(argv[i + 1]));
+    else usage = true;
+  }
+  if (usage) {
+    fprintf(stderr, "usage : %s [-csv file] [-json file] [-baseline file] [-threshold percent] [-runs count]\n", argv[0]);
+    return 2;
+  }
+  std::vector<result> baseline;
+  if (baselinePath) {
+    baseline = readCsv(baselinePath);
+    if (baseline.empty()) {
+      fprintf(stderr, "no results in baseline %s\n", baselinePath);
+      return 2;
+    }
+  }
+
+  const char* compiler = getenv("CXX") ? getenv("CXX") : "g++";
+  char name[64], command[512];
+  for (size_t c = 0; c < CONFIGS; c++) { // all builds first, so that runs can be interleaved
+    const config& cfg = configs[c];
+    fprintf(stderr, "building ES8=%u EPSILON=%s%s\n", cfg.es8, cfg.epsilon, cfg.noFloat ? " POSIT_NO_FLOAT" : "");
+    childName(name, sizeof(name), c);
+    snprintf(command, sizeof(command), "%s -O2 -I. -I../../src -DCONFIG_CHILD -DES8=%u -DEPSILON=%s %s %s -o %s",
+             compiler, cfg.es8, cfg.epsilon, cfg.noFloat ? "-DPOSIT_NO_FLOAT" : "", __FILE__, name);
+    if (system(command)) {
+      fprintf(stderr, "build failed : %s\n", command);
+      return 2;
+    }
+  }
+
+  std::vector<result> results;
+  std::vector<bool> selected(CONFIGS, true);
+  bool failed = !measure(selected, runs, results);
+  for (size_t i = 0; i < results.size(); i++) {
+    for (size_t b = 0; b < baseline.size(); b++) {
+      if (baseline[b].key == results[i].key) results[i].baseline = baseline[b].ns;
+    }
+  }
+  double speed = 1;
+  uint32_t slower = failed ? 0 : compare(results, threshold, speed);
+  bool slowerOverall = speed > 1 + threshold / 100;
+  if (!failed && (slower || slowerOverall)) {
+    // A slow line only counts if it is slow again : a second pass runs the configurations
+    // concerned (all of them if the median is off), and keeps the best times of both
+    fprintf(stderr, "%lu times slower than the baseline%s, confirming\n", (unsigned long) slower,
+            slowerOverall ? " and median beyond the threshold" : "");
+    for (size_t c = 0; c < CONFIGS; c++) selected[c] = slowerOverall;
+    for (size_t i = 0; i < results.size(); i++) if (results[i].regression) selected[results[i].config] = true;
+    failed = !measure(selected, runs, results);
+    slower = failed ? 0 : compare(results, threshold, speed);
+    slowerOverall = speed > 1 + threshold / 100;
+  }
+  for (size_t c = 0; c < CONFIGS; c++) {
+    childName(name, sizeof(name), c);
+    remove(name);
+  }
+  if (failed) {
+    fprintf(stderr, "a benchmark run failed\n");
+    return 2;
+  }
+
+  printf("%-44s %9s %9s\n", "es8,epsilon,conversions,op,bucket", "ns/op", "baseline");
+  for (size_t i = 0; i < results.size(); i++) {
+    const result& r = results[i];
+    if (r.baseline) printf("%-44s %9.2f %9.2f%s\n", r.key.c_str(), r.ns, r.baseline, r.regression ? "  SLOWER" : "");
+    else printf("%-44s %9.2f\n", r.key.c_str(), r.ns);
+  }
+
+  if (csvPath) {
+    FILE* file = fopen(csvPath, "w");
+    if (!file) return 2;
+    fprintf(file, "es8,epsilon,conversions,op,bucket,ns_per_op\n");
+    for (size_t i = 0; i < results.size(); i++) fprintf(file, "%s,%.3f\n", results[i].key.c_str(), results[i].ns);
+    fclose(file);
+  }
+  if (jsonPath) {
+    FILE* file = fopen(jsonPath, "w");
+    if (!file) return 2;
+    fprintf(file, "{\n  \"threshold_percent\": %g,\n  \"median_ratio\": %.3f,\n  \"regressions\": %lu,\n  \"results\": [\n",
+            threshold, speed, (unsigned long) slower);
+    for (size_t i = 0; i < results.size(); i++) {
+      const result& r = results[i];
+      char es8[8], epsilon[16], conversions[16], op[32], bucket[16];
+      sscanf(r.key.c_str(), "%7[^,],%15[^,],%15[^,],%31[^,],%15s", es8, epsilon, conversions, op, bucket);
+      fprintf(file, "    {\"es8\": %s, \"epsilon\": %s, \"conversions\": \"%s\", \"op\": \"%s\", \"bucket\": \"%s\", \"ns_per_op\": %.3f",
+              es8, epsilon, conversions, op, bucket, r.ns);
+      if (r.baseline) fprintf(file, ", \"baseline\": %.3f, \"ratio\": %.3f", r.baseline, r.ns / r.baseline);
+      fprintf(file, "}%s\n", i + 1 < results.size() ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+    fclose(file);
+  }
+  if (baselinePath) {
+    printf("median time ratio %.3f against %s, %lu of %lu times more than %g%% slower after scaling\n", speed,
+           baselinePath, (unsigned long) slower, (unsigned long) results.size(), threshold);
+    if (slowerOverall) printf("everything is slower : check the machine, or a change affecting all operations\n");
+  }
+  return (slower || slowerOverall) ? 1 : 0;
+}
+
+#endif // CONFIG_CHILD
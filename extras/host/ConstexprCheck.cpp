@@ -0,0 +1,75 @@
+/*************************************************************************************
+  Compile-time check of the constexpr constructors of Posit.h : this program only builds
+  if, for the configured ES8 and EPSILON,
+  - posit16_t(int) and posit8_t(int) give the same bits as the float constructors for
+    every integer from -40000 to 40000
+  - splitting every posit16_t and posit8_t pattern and packing the parts again gives
+    the same pattern back
+  Everything is evaluated by static_assert, so it needs C++17 and __builtin_bit_cast
+  (gcc 11, clang 9). Running it only prints a confirmation.
+
+  Build and run from this directory (also with -DES8=1 or -DES8=2) :
+    g++ -std=gnu++17 -I. -I../../src ConstexprCheck.cpp -o ConstexprCheck && ./ConstexprCheck
+************************************************************************************/
+
+#include "Arduino.h"
+#include "Posit.h"
+
+#ifndef POSIT_BIT_CAST
+#error "needs C++17 and __builtin_bit_cast, e.g. g++ -std=gnu++17"
+#endif
+
+// Ranges are checked in blocks to stay below the compilers' constexpr evaluation limits
+constexpr bool intMatchesFloat(long first, long last) {
+  for (long i = first; i < last; i++) {
+    if (posit16_t((int) i).value != posit16_t((float) i).value) return false;
+    if (posit8_t((int) i).value != posit8_t((float) i).value) return false;
+  }
+  return true;
+}
+
+constexpr bool splitPacks16(uint32_t first, uint32_t last) {
+  for (uint32_t raw = first; raw < last; raw++) {
+    if (raw == 0 || raw == 0x8000) continue; // zero and NaR have no parts
+    bool sign = false;
+    int8_t powerof2 = 0;
+    uint16_t mantissa = 0;
+    posit16_t::positSplit(posit16_t((uint16_t) raw), sign, powerof2, mantissa);
+    mantissa <<= 1; // eliminate leading one
+    if (posit16_t(sign, powerof2, mantissa).value != raw) return false;
+  }
+  return true;
+}
+
+constexpr bool splitPacks8() {
+  for (uint16_t raw = 1; raw < 0x100; raw++) {
+    if (raw == 0x80) continue; // NaR
+    bool sign = false;
+    int8_t powerof2 = 0;
+    uint8_t mantissa = 0;
+    posit8_t::positSplit(posit8_t((uint8_t) raw), sign, powerof2, mantissa);
+    mantissa <<= 1; // eliminate leading one
+    if (posit8_t(sign, powerof2, mantissa).value != raw) return false;
+  }
+  return true;
+}
+
+// One static_assert per block, each one is a separate constant evaluation
+template <long FIRST, long LAST, bool MORE = (FIRST < LAST)> struct intBlocks : intBlocks<FIRST + 2000, LAST> {
+  static_assert(intMatchesFloat(FIRST, FIRST + 2000 < LAST ? FIRST + 2000 : LAST), "int and float constructors differ");
+};
+template <long FIRST, long LAST> struct intBlocks<FIRST, LAST, false> {};
+
+template <uint32_t FIRST, bool MORE = (FIRST < 0x10000)> struct split16Blocks : split16Blocks<FIRST + 0x800> {
+  static_assert(splitPacks16(FIRST, FIRST + 0x800), "posit16 split/pack round trip");
+};
+template <uint32_t FIRST> struct split16Blocks<FIRST, false> {};
+
+template struct intBlocks<-40000, 40001>;
+template struct split16Blocks<0>;
+static_assert(splitPacks8(), "posit8 split/pack round trip");
+
+int main() {
+  printf("ES8 = %d : int constructors match float ones on -40000..40000, split/pack round-trips\n", ES8);
+  return 0;
+}
@@ -0,0 +1,191 @@
+/*************************************************************************************
+  Host benchmark of PositDSP.h : a 32-tap lowpass FIR filter and a 256-point FFT, each
+  computed with posit16_t operators (one truncation per operation), with the kernels of
+  PositDSP.h (one truncation per output) and with float. Errors are against double.
+
+  Build and run from this directory :
+    g++ -O2 -I. -I../../src DSPBenchmark.cpp -o DSPBenchmark && ./DSPBenchmark
+  The signal is a sum of two sines and some noise, amplitude about one.
+************************************************************************************/
+
+#include "Arduino.h"
+#include "PositDSP.h"
+
+#define TAPS 32
+#define SAMPLES 4096
+#define POINTS 256
+#define ROUNDS 20
+
+static posit16_t signal16[SAMPLES];
+static double signal[SAMPLES];
+
+static void makeSignal() {
+  uint32_t seed = 2024;
+  for (uint16_t i = 0; i < SAMPLES; i++) {
+    seed = seed * 1664525UL + 1013904223UL;
+    double noise = ((seed >> 8) / 16777216.0 - 0.5) * 0.2;
+    signal16[i] = posit16_t((float)(0.6 * sin(0.05 * i) + 0.3 * sin(1.3 * i) + noise));
+    signal[i] = posit2float(signal16[i]); // same input for all versions
+  }
+}
+
+static double errorAgainst(const posit16_t* values, const double* reference, uint16_t count) {
+  double error = 0;
+  for (uint16_t i = 0; i < count; i++) error = max(error, fabs(posit2float(values[i]) - reference[i]));
+  return error;
+}
+
+static double errorAgainst(const float* values, const double* reference, uint16_t count) {
+  double error = 0;
+  for (uint16_t i = 0; i < count; i++) error = max(error, fabs(values[i] - reference[i]));
+  return error;
+}
+
+static void fir() {
+  posit16_t taps[TAPS];
+  double tapsDouble[TAPS];
+  for (uint8_t k = 0; k < TAPS; k++) { // windowed sinc, cutoff at a tenth of the sample rate
+    double x = k - (TAPS - 1) / 2.0;
+    double window = 0.54 - 0.46 * cos(2 * M_PI * k / (TAPS - 1));
+    taps[k] = posit16_t((float)(0.2 * window * (x ? sin(0.2 * M_PI * x) / (0.2 * M_PI * x) : 1)));
+    tapsDouble[k] = posit2float(taps[k]);
+  }
+  static double reference[SAMPLES];
+  for (uint16_t n = 0; n < SAMPLES; n++) {
+    reference[n] = 0;
+    for (uint8_t k = 0; k < TAPS && k <= n; k++) reference[n] += tapsDouble[k] * signal[n - k];
+  }
+
+  static posit16_t chain[SAMPLES], kernel[SAMPLES];
+  static float single[SAMPLES];
+  unsigned long start = micros();
+  for (uint8_t round = 0; round < ROUNDS; round++) {
+    for (uint16_t n = 0; n < SAMPLES; n++) {
+      posit16_t sum = posit16_t((uint16_t) 0);
+      for (uint8_t k = 0; k < TAPS && k <= n; k++) sum = sum + taps[k] * signal16[n - k];
+      chain[n] = sum;
+    }
+  }
+  unsigned long chainTime = micros() - start;
+
+  posit16_t delay[TAPS];
+  start = micros();
+  for (uint8_t round = 0; round < ROUNDS; round++) {
+    positFIR filter(taps, delay, TAPS);
+    filter.filter(signal16, kernel, SAMPLES);
+  }
+  unsigned long kernelTime = micros() - start;
+
+  float tapsFloat[TAPS];
+  for (uint8_t k = 0; k < TAPS; k++) tapsFloat[k] = tapsDouble[k];
+  start = micros();
+  for (uint8_t round = 0; round < ROUNDS; round++) {
+    for (uint16_t n = 0; n < SAMPLES; n++) {
+      float sum = 0;
+      for (uint8_t k = 0; k < TAPS && k <= n; k++) sum += tapsFloat[k] * (float) signal[n - k];
+      single[n] = sum;
+    }
+  }
+  unsigned long floatTime = micros() - start;
+
+  double perSample = 1000.0 / ((double) SAMPLES * ROUNDS);
+  printf("FIR filter, %d taps, %d samples, max error against double\n", TAPS, SAMPLES);
+  printf("  posit16 operators %7.1f ns/sample  error %.2e\n", chainTime * perSample, errorAgainst(chain, reference, SAMPLES));
+  printf("  positFIR          %7.1f ns/sample  error %.2e\n", kernelTime * perSample, errorAgainst(kernel, reference, SAMPLES));
+  printf("  float             %7.1f ns/sample  error %.2e\n", floatTime * perSample, errorAgainst(single, reference, SAMPLES));
+}
+
+// Textbook radix-2 FFT (decimation in time, bit-reversed input), for posit16_t and float
+template <typename T> static void radix2(T* re, T* im, uint16_t n, const T* cosine, const T* sine) {
+  for (uint16_t i = 1, j = 0; i < n; i++) {
+    uint16_t bit = n >> 1;
+    for (; j & bit; bit >>= 1) j ^= bit;
+    j |= bit;
+    if (i < j) {
+      T swap = re[i]; re[i] = re[j]; re[j] = swap;
+      swap = im[i]; im[i] = im[j]; im[j] = swap;
+    }
+  }
+  for (uint16_t length = 2; length <= n; length <<= 1) {
+    uint16_t half = length >> 1, step = n / length;
+    for (uint16_t start = 0; start < n; start += length) {
+      for (uint16_t k = 0; k < half; k++) {
+        uint16_t a = start + k, b = a + half;
+        T c = cosine[k * step], s = sine[k * step]; // W = c - i s
+        T tr = re[b] * c + im[b] * s, ti = im[b] * c - re[b] * s;
+        re[b] = re[a] - tr; im[b] = im[a] - ti;
+        re[a] = re[a] + tr; im[a] = im[a] + ti;
+      }
+    }
+  }
+}
+
+static void fft() {
+  static double referenceRe[POINTS], referenceIm[POINTS];
+  double largest = 0;
+  for (uint16_t k = 0; k < POINTS; k++) { // direct DFT of the real signal
+    referenceRe[k] = referenceIm[k] = 0;
+    for (uint16_t i = 0; i < POINTS; i++) {
+      referenceRe[k] += signal[i] * cos(2 * M_PI * i * k / POINTS);
+      referenceIm[k] -= signal[i] * sin(2 * M_PI * i * k / POINTS);
+    }
+    largest = max(largest, hypot(referenceRe[k], referenceIm[k]));
+  }
+  posit16_t cosine16[POINTS / 2], sine16[POINTS / 2];
+  float cosineFloat[POINTS / 2], sineFloat[POINTS / 2];
+  for (uint16_t k = 0; k < POINTS / 2; k++) {
+    cosineFloat[k] = cos(2 * M_PI * k / POINTS);
+    sineFloat[k] = sin(2 * M_PI * k / POINTS);
+    cosine16[k] = posit16_t(cosineFloat[k]);
+    sine16[k] = posit16_t(sineFloat[k]);
+  }
+  const uint16_t FFTS = 50 * ROUNDS;
+
+  static posit16_t chainRe[POINTS], chainIm[POINTS], kernelRe[POINTS], kernelIm[POINTS];
+  static float floatRe[POINTS], floatIm[POINTS];
+  unsigned long start = micros();
+  for (uint16_t round = 0; round < FFTS; round++) {
+    for (uint16_t i = 0; i < POINTS; i++) {
+      chainRe[i] = signal16[i];
+      chainIm[i].value = 0;
+    }
+    radix2(chainRe, chainIm, POINTS, cosine16, sine16);
+  }
+  unsigned long chainTime = micros() - start;
+
+  static int32_t work[2 * POINTS];
+  start = micros();
+  for (uint16_t round = 0; round < FFTS; round++) {
+    for (uint16_t i = 0; i < POINTS; i++) {
+      kernelRe[i] = signal16[i];
+      kernelIm[i].value = 0;
+    }
+    posit16_fft(kernelRe, kernelIm, POINTS, work);
+  }
+  unsigned long kernelTime = micros() - start;
+
+  start = micros();
+  for (uint16_t round = 0; round < FFTS; round++) {
+    for (uint16_t i = 0; i < POINTS; i++) {
+      floatRe[i] = signal[i];
+      floatIm[i] = 0;
+    }
+    radix2(floatRe, floatIm, POINTS, cosineFloat, sineFloat);
+  }
+  unsigned long floatTime = micros() - start;
+
+  printf("FFT, %d points, max error against double (largest output %.1f)\n", POINTS, largest);
+  printf("  posit16 operators %7.2f us/FFT  error %.2e\n", (double) chainTime / FFTS,
+         max(errorAgainst(chainRe, referenceRe, POINTS), errorAgainst(chainIm, referenceIm, POINTS)));
+  printf("  posit16_fft       %7.2f us/FFT  error %.2e\n", (double) kernelTime / FFTS,
+         max(errorAgainst(kernelRe, referenceRe, POINTS), errorAgainst(kernelIm, referenceIm, POINTS)));
+  printf("  float             %7.2f us/FFT  error %.2e\n", (double) floatTime / FFTS,
+         max(errorAgainst(floatRe, referenceRe, POINTS), errorAgainst(floatIm, referenceIm, POINTS)));
+}
+
+int main() {
+  makeSignal();
+  fir();
+  fft();
+  return 0;
+}
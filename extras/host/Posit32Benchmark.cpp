@@ -0,0 +1,106 @@
+/*************************************************************************************
+  Host benchmark of posit32_t (Posit32.h) against float : time per operation and mean
+  relative error against double, on the same operand values (floats are converted
+  from the posits, so both types start from identical numbers).
+
+  Build and run from this directory :
+    g++ -O2 -I. -I../../src Posit32Benchmark.cpp -o Posit32Benchmark && ./Posit32Benchmark
+  A PC has an FPU : the float column is hardware float, far faster than the soft-float
+  routines that ESP32-C3, RP2040 or SAMD21 call for each operation. Compare posit32_t
+  with soft-float on those boards, the host only shows the kernel cost and accuracy.
+  posit32 results are truncated, floats are rounded to nearest : expect up to twice
+  the float error where posit32 has no more mantissa bits than float (far from one).
+************************************************************************************/
+
+#include "Arduino.h"
+#include "Posit32.h"
+
+#define PAIRS 4096 // operands fit in L1 cache, so that the kernels are measured
+#define ROUNDS 500
+
+static uint32_t xorshift(uint32_t& seed) {
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  return seed;
+}
+
+static posit32_t randomPosit(uint32_t& seed, uint32_t spread) { // values around +-1
+  uint32_t raw = 0x40000000UL - spread / 2 + xorshift(seed) % spread; // 0x40000000 is 1.0
+  return posit32_t((uint32_t)((seed & 0x10000UL) ? -raw : raw));
+}
+
+static double positToDouble(posit32_t p) { // exact, posit32 mantissas fit in double
+  bool sign;
+  int16_t powerof2;
+  uint32_t mantissa;
+  if (p.value == 0) return 0;
+  posit32_t::positSplit(p, sign, powerof2, mantissa);
+  double magnitude = ldexp((double) mantissa, powerof2 - 31);
+  return sign ? -magnitude : magnitude;
+}
+
+static double relativeError(double actual, double expected) {
+  return expected ? fabs((actual - expected) / expected) : fabs(actual);
+}
+
+static void benchmark(const char* name, uint32_t spread) {
+  static posit32_t pa[PAIRS], pb[PAIRS];
+  static float fa[PAIRS], fb[PAIRS];
+  uint32_t seed = 12345;
+  for (uint16_t i = 0; i < PAIRS; i++) {
+    pa[i] = randomPosit(seed, spread);
+    pb[i] = randomPosit(seed, spread);
+    fa[i] = posit2float(pa[i]); // truncated to 23 bits ...
+    fb[i] = posit2float(pb[i]);
+    pa[i] = posit32_t(fa[i]); // ... so that posits hold the very same values
+    pb[i] = posit32_t(fb[i]);
+  }
+
+  const char* opNames[4] = {"add", "mul", "div", "sqrt"};
+  printf("%s\n", name);
+  for (uint8_t op = 0; op < 4; op++) {
+    volatile uint32_t sink = 0;
+    unsigned long start = micros();
+    for (uint16_t round = 0; round < ROUNDS; round++) {
+      uint32_t sum = 0;
+      for (uint16_t i = 0; i < PAIRS; i++) {
+        posit32_t r = op == 0 ? pa[i] + pb[i] : op == 1 ? pa[i] * pb[i] : op == 2 ? pa[i] / pb[i] : posit32_sqrt(pa[i] * pa[i]);
+        sum += r.value;
+      }
+      sink = sink + sum;
+    }
+    unsigned long positTime = micros() - start;
+
+    volatile float floatSink = 0;
+    start = micros();
+    for (uint16_t round = 0; round < ROUNDS; round++) {
+      float sum = 0;
+      for (uint16_t i = 0; i < PAIRS; i++) {
+        float r = op == 0 ? fa[i] + fb[i] : op == 1 ? fa[i] * fb[i] : op == 2 ? fa[i] / fb[i] : sqrtf(fa[i] * fa[i]);
+        sum += r;
+      }
+      floatSink = floatSink + sum;
+    }
+    unsigned long floatTime = micros() - start;
+
+    double positError = 0, floatError = 0;
+    for (uint16_t i = 0; i < PAIRS; i++) {
+      double a = fa[i], b = fb[i];
+      double exact = op == 0 ? a + b : op == 1 ? a * b : op == 2 ? a / b : fabs(a);
+      posit32_t p = op == 0 ? pa[i] + pb[i] : op == 1 ? pa[i] * pb[i] : op == 2 ? pa[i] / pb[i] : posit32_sqrt(pa[i] * pa[i]);
+      float f = op == 0 ? fa[i] + fb[i] : op == 1 ? fa[i] * fb[i] : op == 2 ? fa[i] / fb[i] : sqrtf(fa[i] * fa[i]);
+      positError += relativeError(positToDouble(p), exact);
+      floatError += relativeError(f, exact);
+    }
+    printf("  %-5s posit32 %6.2f ns/op  float %6.2f ns/op   mean rel. error posit32 %.2e  float %.2e\n",
+           opNames[op], 1000.0 * positTime / ((double) PAIRS * ROUNDS), 1000.0 * floatTime / ((double) PAIRS * ROUNDS),
+           positError / PAIRS, floatError / PAIRS);
+  }
+}
+
+int main() {
+  benchmark("close to one (filters, probabilities)", 0x01000000UL);
+  benchmark("spread magnitudes", 0x20000000UL);
+  return 0;
+}
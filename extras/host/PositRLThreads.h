@@ -0,0 +1,58 @@
+/*************************************************************************************
+  Multithreaded replay of recorded transitions on a PC, for offline training sweeps of
+  the posit tables of PositRL.h (then copied to the board, for example through
+  PositStream.h). Needs C++11 threads : g++ -O2 -pthread ...
+
+  positSweep() is synchronous, like value iteration : all targets are computed from the
+  table as it is at the start of the sweep, then each entry gets the updates of all its
+  transitions (in batch order) and is packed once. Each thread owns the entries with
+  index % threads == its number, so results do not depend on the thread count. They
+  differ from positTD::update(), where targets may already see entries of the batch.
+************************************************************************************/
+
+#ifndef POSIT_RL_THREADS_H
+#define POSIT_RL_THREADS_H
+
+#include "PositRL.h"
+#include <thread>
+#include <vector>
+
+// Run work(part) for part = 0 .. parts-1 in parallel, and wait for all of them
+template <typename F> static void positParallel(unsigned parts, F work) {
+  std::vector<std::thread> threads;
+  for (unsigned part = 1; part < parts; part++) threads.push_back(std::thread(work, part));
+  work(0);
+  for (size_t i = 0; i < threads.size(); i++) threads[i].join();
+}
+
+template <typename P> static void positSweep(const positTD& td, P* q, uint32_t entries,
+    const positTransition* batch, uint32_t count, uint8_t rule, unsigned threads) {
+  if (threads < 1) threads = 1;
+  std::vector<splitPosit> targets(count);
+  positParallel(threads, [&](unsigned part) { // read only
+    for (uint32_t i = part; i < count; i += threads) targets[i] = td.target(q, batch[i], rule);
+  });
+
+  std::vector<splitPosit> values(entries);
+  std::vector<uint8_t> touched(entries, 0); // not vector<bool> : threads write neighbouring entries
+  for (uint32_t i = 0; i < count; i++) touched[td.entry(batch[i], rule)] = 1;
+  positParallel(threads, [&](unsigned part) {
+    for (uint32_t i = 0; i < count; i++) {
+      uint32_t index = td.entry(batch[i], rule);
+      if (index % threads != part) continue;
+      if (touched[index]) { // first transition of this entry
+        values[index] = q[index];
+        touched[index] = 0;
+      }
+      values[index] += td.alpha * (targets[i] - values[index]);
+    }
+  });
+  positParallel(threads, [&](unsigned part) { // entries of the batch, other ones are unchanged
+    for (uint32_t i = 0; i < count; i++) {
+      uint32_t index = td.entry(batch[i], rule);
+      if (index % threads == part) positStore(q[index], values[index]);
+    }
+  });
+}
+
+#endif // POSIT_RL_THREADS_H
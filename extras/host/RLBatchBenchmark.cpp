@@ -0,0 +1,122 @@
+/*************************************************************************************
+  Host benchmark of the TD updates of PositRL.h on a posit8_t Q-table : operator chain
+  (Q += alpha * (r + gamma * next - Q), one truncation per operation) against positTD
+  (one truncation per entry), then offline sweeps with PositRLThreads.h, checking that
+  the table does not depend on the thread count.
+
+  Build and run from this directory :
+    g++ -O2 -pthread -I. -I../../src RLBatchBenchmark.cpp -o RLBatchBenchmark && ./RLBatchBenchmark
+  Transitions come from a random walk on a chain of states, reward one at the right end :
+  the exact values are gamma^distance, and the error of each table is printed against
+  double updates of the same transitions.
+************************************************************************************/
+
+#include "Arduino.h"
+#include "PositRLThreads.h"
+
+#define STATES 64
+#define ACTIONS 2 // left, right
+#define TRANSITIONS 20000
+#define BATCH 32
+
+static uint32_t xorshift(uint32_t& seed) {
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  return seed;
+}
+
+static positTransition transitions[TRANSITIONS];
+
+static void walk() {
+  uint32_t seed = 2024;
+  uint16_t state = STATES / 2;
+  for (uint32_t i = 0; i < TRANSITIONS; i++) {
+    positTransition& t = transitions[i];
+    t.state = state;
+    t.action = xorshift(seed) & 1;
+    t.nextState = t.action ? state + 1 : (state ? state - 1 : 0);
+    t.terminal = t.nextState == STATES - 1;
+    t.reward = posit16_t(t.terminal ? 1 : 0);
+    t.nextAction = xorshift(seed) & 1;
+    state = t.terminal ? STATES / 2 : t.nextState;
+  }
+}
+
+static void clear(posit8_t* q) {
+  for (uint16_t i = 0; i < STATES * ACTIONS; i++) q[i].value = 0;
+}
+
+static double meanError(const posit8_t* q, const double* reference) {
+  double error = 0;
+  for (uint16_t i = 0; i < STATES * ACTIONS; i++) error += fabs(posit2float(q[i]) - reference[i]);
+  return error / (STATES * ACTIONS);
+}
+
+int main() {
+  walk();
+  const float alpha = 0.25f, gamma = 0.875f; // exact in posit8
+  positTD td(posit16_t(alpha), posit16_t(gamma), ACTIONS);
+  posit8_t alpha8 = posit8_t(alpha), gamma8 = posit8_t(gamma);
+  static posit8_t chain[STATES * ACTIONS], single[STATES * ACTIONS], batched[STATES * ACTIONS];
+  static double reference[STATES * ACTIONS];
+  const uint8_t ROUNDS = 20;
+
+  unsigned long start = micros();
+  for (uint8_t round = 0; round < ROUNDS; round++) {
+    clear(chain);
+    for (uint32_t i = 0; i < TRANSITIONS; i++) { // Q-learning with posit operators
+      const positTransition& t = transitions[i];
+      posit8_t* row = chain + t.nextState * ACTIONS;
+      posit8_t next = t.terminal ? posit8_t(0) : (positOrder(row[1]) > positOrder(row[0]) ? row[1] : row[0]);
+      posit8_t& q = chain[t.state * ACTIONS + t.action];
+      q += alpha8 * (posit8_t(t.terminal ? 1 : 0) + gamma8 * next - q); // same rewards
+    }
+  }
+  unsigned long chainTime = micros() - start;
+
+  start = micros();
+  for (uint8_t round = 0; round < ROUNDS; round++) {
+    clear(single);
+    for (uint32_t i = 0; i < TRANSITIONS; i++) td.qLearning(single, transitions[i]);
+  }
+  unsigned long singleTime = micros() - start;
+
+  start = micros();
+  for (uint8_t round = 0; round < ROUNDS; round++) {
+    clear(batched);
+    for (uint32_t i = 0; i < TRANSITIONS; i += BATCH) td.qLearning(batched, transitions + i, BATCH);
+  }
+  unsigned long batchTime = micros() - start;
+
+  for (uint32_t i = 0; i < TRANSITIONS; i++) { // same updates in double
+    const positTransition& t = transitions[i];
+    double* row = reference + t.nextState * ACTIONS;
+    double target = t.terminal ? 1 : gamma * (row[1] > row[0] ? row[1] : row[0]);
+    double& q = reference[t.state * ACTIONS + t.action];
+    q += alpha * (target - q);
+  }
+
+  double perUpdate = 1000.0 / ((double) TRANSITIONS * ROUNDS);
+  printf("Q-learning, %d transitions on a posit8_t table, mean error against double\n", TRANSITIONS);
+  printf("  operators        %6.1f ns/update  error %.4f\n", chainTime * perUpdate, meanError(chain, reference));
+  printf("  positTD          %6.1f ns/update  error %.4f\n", singleTime * perUpdate, meanError(single, reference));
+  printf("  positTD batch %-2d %6.1f ns/update  error %.4f\n", BATCH, batchTime * perUpdate, meanError(batched, reference));
+
+  // Offline sweeps : the whole recording per sweep, synchronous targets
+  const unsigned threadCounts[3] = {1, 2, 8}; // no gain beyond the count of cores, see hardware_concurrency()
+  static posit8_t first[STATES * ACTIONS];
+  for (uint8_t k = 0; k < 3; k++) {
+    static posit8_t swept[STATES * ACTIONS];
+    clear(swept);
+    start = micros();
+    for (uint8_t sweep = 0; sweep < ROUNDS; sweep++) {
+      positSweep(td, swept, STATES * ACTIONS, transitions, TRANSITIONS, positTD::Q_LEARNING, threadCounts[k]);
+    }
+    unsigned long sweepTime = micros() - start;
+    if (k == 0) memcpy(first, swept, sizeof(first));
+    printf("  sweeps, %2u threads %6.1f ns/update  same table as 1 thread : %s\n", threadCounts[k],
+           sweepTime * perUpdate, memcmp(first, swept, sizeof(first)) ? "NO" : "yes");
+  }
+  return 0;
+}
@@ -0,0 +1,34 @@
+/*************************************************************************************
+  Generator of the twiddle table in PositDSP.h : posit16 values of sin(2 * pi * m / 1024)
+  for m = 0 to 256 (a quarter wave, the FFT gets other angles by symmetry), rounded to
+  nearest since they are constants rather than results of operations. Built with
+  POSIT_NO_FLOAT so that posits are made from all 52 bits of double results.
+
+  Build and run from this directory :
+    g++ -O2 -I. -I../../src TwiddleTable.cpp -o TwiddleTable && ./TwiddleTable
+************************************************************************************/
+
+#define POSIT_NO_FLOAT
+#include "Arduino.h"
+#include "Posit.h"
+
+static double value16(uint16_t raw) { // exact
+  bool sign;
+  int8_t powerof2;
+  uint16_t mantissa;
+  if (raw == 0) return 0;
+  posit16_t::positSplit(posit16_t(raw), sign, powerof2, mantissa);
+  return (sign ? -1 : 1) * ldexp(mantissa, powerof2 - 15);
+}
+
+int main() {
+  printf("static const uint16_t positSine16Table[257] PROGMEM = { // sin(2 * pi * index / 1024)\n");
+  for (uint16_t m = 0; m <= 256; m++) {
+    double sine = sin(2 * M_PI * m / 1024);
+    uint16_t raw = posit16_t(sine).value; // truncated, the next posit may be closer
+    if (raw < 0x4000 && fabs(value16(raw + 1) - sine) < fabs(value16(raw) - sine)) raw++;
+    printf("%s0x%04X%s", m % 8 ? " " : "  ", raw, m == 256 ? "\n" : m % 8 == 7 ? ",\n" : ",");
+  }
+  printf("};\n");
+  return 0;
+}
@@ -12,7 +12,8 @@ Posit Library for Arduino v0.1.3 (not yet released)
   - Useful, explanatory comments in the library
  
   As corollary, major non-goals are :
-  - Support for 32bits posits (not enough added value compared with existing floats)
+  - Support for 32bits posits on AVR (not enough added value compared with existing floats),
+    posit32_t is only in the optional Posit32.h, for 32-bit boards without FPU
   - Full compliance with the Posit-2022 standard (too many functions)
   - Complex rounding algorithms (rounding to nearest even requires handling G, R and S bits)
   - Support of quire (very long accumulator)
@@ -53,6 +54,9 @@ Posit Library for Arduino v0.1.3 (not yet released)
 See https://github.com/tochinet/Posit/ for more details on Posits and the library.
 ************************************************************************************/
 
+#ifndef POSIT_H // Include guard, since add-on headers (PositFormat.h ...) include Posit.h too
+#define POSIT_H
+
 #ifndef EPSILON     // Define EPSILON in sketch for rounding down ...
 #define EPSILON 0.0 // ... results smaller than EPSILON to zero in Posit8 ... 
 #endif              // ... and EPSILON^2 in Posit16 arithmetic
@@ -63,18 +67,85 @@ See https://github.com/tochinet/Posit/ for more details on Posits and the librar
 #define ES8 2 // or defaults to two exponent bits (standard)
 #endif
 #define ES16 2 // Posit 16 always have two-bits exponent field
-//#define ES32 2 // No support envisioned for Posit32.
 //#define NOTRIG // uncomment or put in sketch to exclude trig routines
+//#define POSIT_NO_FLOAT // uncomment or put in sketch to avoid any float arithmetic (soft-float on AVR)
+// Float constructors then only reinterpret IEEE754 bits and division uses integer mantissas,
+// so that sketches which never print floats don't link the float library at all.
+
+// Constructors and positSplit are constexpr when the compiler allows loops in constexpr
+// functions (C++14, e.g. ESP32 or -std=gnu++17), so that constants become bit patterns.
+// Float constructors also need __builtin_bit_cast (gcc 11, clang 9) to read IEEE754 bits.
+// With the gnu++11 default of AVR cores, they are ordinary (inline) functions.
+#if __cplusplus >= 201402L
+#define POSIT_CONSTEXPR constexpr
+#else
+#define POSIT_CONSTEXPR
+#endif
+#ifdef __has_builtin
+#if __has_builtin(__builtin_bit_cast) && __cplusplus >= 201402L
+#define POSIT_BIT_CAST
+#endif
+#endif
+#ifdef POSIT_BIT_CAST
+#define POSIT_CONSTEXPR_FLOAT constexpr
+#else
+#define POSIT_CONSTEXPR_FLOAT
+#endif
 
 #ifdef DEBUG
 char s[30]; // temporary C string for Serial debug using sprintf
 #endif
 
-struct splitPosit { // struct not used yet. TODO check if it reduces or increases memory usage
-  bool sign;
-  int8_t powerof2; // 2's power, combining regime and exponent fields
-  uint16_t mantissa; // worth using 16 bits to share struct between 8 and 16 bits
-}; 
+// Count of leading zero bits in a nonzero 16-bit value, used to renormalize after subtraction
+static uint8_t clz16(uint16_t x) {
+#ifdef __GNUC__ // single instruction on ARM and x86, small libgcc loop on AVR
+  return __builtin_clz(x) - (sizeof(unsigned int) * 8 - 16);
+#else
+  uint8_t zeros = 0;
+  if (!(x & 0xFF00)) { // skip a whole byte at once
+    zeros = 8;
+    x <<= 8;
+  }
+  while (!(x & 0x8000)) {
+    zeros++;
+    x <<= 1;
+  }
+  return zeros;
+#endif
+}
+
+static uint8_t clz32(uint32_t x) { // x != 0
+  return (x >> 16) ? clz16(x >> 16) : 16 + clz16(x);
+}
+
+// IEEE754 bits of a float, at compile time when __builtin_bit_cast exists
+static inline POSIT_CONSTEXPR_FLOAT uint32_t floatBits(float v) {
+#ifdef POSIT_BIT_CAST
+  return __builtin_bit_cast(uint32_t, v);
+#else
+  union float_int { // for bit manipulation
+    float tempFloat;
+    uint32_t tempInt; // little-endian in AVR
+  } tempValue;
+  tempValue.tempFloat = v;
+  return tempValue.tempInt;
+#endif
+}
+
+#if __SIZEOF_DOUBLE__ == 8 // also used by posit32_t (Posit32.h)
+static inline POSIT_CONSTEXPR_FLOAT uint64_t doubleBits(double v) {
+#ifdef POSIT_BIT_CAST
+  return __builtin_bit_cast(uint64_t, v);
+#else
+  union double_int { // for bit manipulation
+    double tempDouble;
+    uint64_t tempInt;
+  } tempValue;
+  tempValue.tempDouble = v;
+  return tempValue.tempInt;
+#endif
+}
+#endif
 
 class posit8_t; // Forward-declared for casting from posit8_t to posit16_t
 
@@ -85,10 +156,10 @@ class posit16_t {
   public: 
   uint16_t value;
 
-  posit16_t(uint16_t v = 0): value(v) {} // default constructor, raw from unsigned 16-bit value
+  constexpr posit16_t(uint16_t v = 0): value(v) {} // default constructor, raw from unsigned 16-bit value
 
   // construct from parts (sign, 2's power and mantissa without leading 1)
-  posit16_t(bool& sign, int8_t powerof2, uint16_t& tempMantissa) {
+  POSIT_CONSTEXPR posit16_t(bool& sign, int8_t powerof2, uint16_t& tempMantissa): value(0) {
     // powerof2 passed by value, as it will be modified
     // sign and mantissa passed by reference to avoid copy, they won't be modified.
     // REJECTED using mantissa with leading one. But mantissa might be moved down someday
@@ -112,7 +183,8 @@ class posit16_t {
       bitCount--; // skip terminating zero
     } else { // abs(v) < 1, regime bits are zero
       while (powerof2++ < 0 && bitCount--> 0); // do nothing
-      tempResult |= (1 << bitCount--); // set terminating 1
+      if (bitCount >= 0) tempResult |= (1 << bitCount); // set terminating 1, none if underflow
+      bitCount--;
     }
     if (bitCount >= 0 && ES16 == 2) { // still space for exp field
       if (esBits & 2) tempResult |= (1 << bitCount);
@@ -132,75 +204,75 @@ class posit16_t {
     this->value=sign?~tempResult+1:tempResult; // 2's complement for negative numbers
   } // end of posit16 constructor from parts
 
-  posit16_t(float v = 0) { // Construct from float32, IEEE754 format
-    union float_int { // for bit manipulation
-      float tempFloat;
-      uint32_t tempInt; // little-endian in AVR
-      uint8_t tempBytes[4]; // [3] includes sign and exponent MSBs
-    } tempValue;
-    bool sign = 0;
+  POSIT_CONSTEXPR_FLOAT posit16_t(float v): value(0) { // Construct from float32, IEEE754 format
+    // only bit manipulations, positive floats are ordered like integers
+    uint32_t bits = floatBits(v);
+    bool sign = bits >> 31;
 
-    this->value = 0;
-    if (v < 0) { // negative numbers
-      if (v >= -EPSILON * EPSILON) return; // lower underflow limit for Posit16
-      sign = 1; // set sign and continue
-    } else { // v>=0
-      if (v <= EPSILON * EPSILON) return;
-    }
-    if (isnan(v)) {
+    bits <<= 1; // eliminate sign, byte-align exponent and mantissa
+    if (bits <= floatBits(EPSILON * EPSILON) << 1) return; // zero or underflow
+    if (bits > 0xFF000000UL) { // NaN
       this->value = 0x8000; // NaR
       return;
     }
-
-    tempValue.tempFloat = v;
-    tempValue.tempInt <<= 1; // eliminate sign, byte-align exponent and mantissa
-    int8_t exponent = tempValue.tempBytes[3] - 127;
-    uint16_t mantissa = (tempValue.tempBytes[2] << 8) + tempValue.tempBytes[1];
+    int8_t exponent = (uint8_t)(bits >> 24) - 127;
+    uint16_t mantissa = bits >> 8;
     // 7 and >>1 if leading one, but no need to "recreate" leading one
 
     this->value = posit16_t(sign, exponent, mantissa).value;
   }
 
-  posit16_t(double v = 0) { // Construct from double by casting to float32
-    this->value = posit16_t((float)v).value;
-  }
-
-  posit16_t(int v = 0) { // Construct from int by casting to float to KISShort
-    this->value = posit16_t((float)v).value;
-    /* TODO : construct from int algorithm : first get log2(N), then extract mantissa
-    // algorithm copied from https://graphics.stanford.edu/~seander/bithacks.html
-    uint32_t v;         // 32-bit value to find the log2 of the argument
-    uint8_t exponent=0; // result of log2(v) will go here
-    uint8_t shift; // each bit of the log2
-    uint16_t mantissa=v; // Copy of the argument needed to fill mantissa!
-    // exponent = (v > 0xFFFF) << 4; v >>= exponent; // only for long values
-    shift = (v > 0xFF  ) << 3; v >>= shift; exponent |= shift;
-    shift = (v > 0xF   ) << 2; v >>= shift; exponent |= shift;
-    shift = (v > 0x3   ) << 1; v >>= shift; exponent |= shift;
-    exponent |= (v >> 1);
-    // then extract mantissa (all other bits shifted right). 
-    mantissa <<= 16-exponent;
-    // then fill posit(sign, exponent, mantissa);
-    */  }
+#if defined(POSIT_NO_FLOAT) && __SIZEOF_DOUBLE__ == 8
+  POSIT_CONSTEXPR_FLOAT posit16_t(double v): value(0) { // Construct from float64 bits, casting to float would use soft-float
+    bool sign = doubleBits(v) >> 63;
+    uint64_t magnitude = doubleBits(v) & 0x7FFFFFFFFFFFFFFFULL;
+
+    if (magnitude <= doubleBits(EPSILON * EPSILON)) return; // zero or underflow
+    if (magnitude > 0x7FF0000000000000ULL) { // NaN
+      this->value = 0x8000; // NaR
+      return;
+    }
+    int16_t exponent = (magnitude >> 52) - 1023;
+    if (exponent > 120) exponent = 120; // saturates to maxpos anyway
+    if (exponent < -120) exponent = -120;
+    uint16_t mantissa = magnitude >> 36; // 16 msbs of 52-bit mantissa
+    this->value = posit16_t(sign, exponent, mantissa).value;
+  }
+#else
+  POSIT_CONSTEXPR_FLOAT posit16_t(double v): posit16_t((float) v) {} // Construct from double by casting to float32
+#endif
+
+  POSIT_CONSTEXPR posit16_t(int v): value(0) { // Construct from int without float : get log2(N), then extract mantissa
+    bool sign = v < 0;
+    unsigned int magnitude = sign ? -(unsigned int)v : v;
+    int8_t powerof2 = -1;
+    uint16_t mantissa = 0;
+
+    if (v == 0) return; // EPSILON below one never changes integers
+    for (unsigned int rest = magnitude; rest; rest >>= 1) powerof2++;
+    // left-align bits after leading one, 16-bit int on AVR, 32-bit on ARM/ESP
+    if (powerof2 <= 15) mantissa = magnitude << (15 - powerof2);
+    else mantissa = magnitude >> (powerof2 - 15);
+    mantissa <<= 1; // eliminate leading one
+    this->value = posit16_t(sign, powerof2, mantissa).value;
+  }
 
   posit16_t(posit8_t) ; // forward declaration
   // End of constructors
 
-  static void positSplit(posit16_t p, bool& sign, int8_t& powerof2, uint16_t& mantissa) {
-    // TODO maybe use splitPosit struct ?
+  static POSIT_CONSTEXPR void positSplit(posit16_t p, bool& sign, int8_t& powerof2, uint16_t& mantissa) {
     // Reads posit16_t by value, writes sign, powerof2 and mantissa (with leading 1)
-    bool bigNum; // true for abs(p) >= 1
     int8_t bitCount= 5+8; // posit bit counter for regime, exponent and mantissa
 
     sign = (p.value & 0x8000);
     if (sign) p.value = -p.value; // intrinsic cast to signed and back
     powerof2 = -(1 << ES16); // negative exponents start at -1/-2/-4;
     // Note: We use "power of 2" to avoid confusion with the exponent field (2 lsbs outside regime)
-    bigNum = (p.value >= 0x4000 && p.value < 0xC000);
+    bool bigNum = (p.value >= 0x4000 && p.value < 0xC000); // true for abs(p) >= 1
     if (bigNum) powerof2 = 0; // positive exponents start at 0
 
     //first extract power of 2 from regime bits
-    while ((p.value & (1 << bitCount)) == ((bigNum) << bitCount--)) { // still regime
+    while (((p.value >> bitCount--) & 1) == bigNum) { // still regime
       if (bigNum) powerof2 += 1 << ES16;
       else powerof2 -= 1 << ES16; // add/sub 2^es for each bit in regime
       if (bitCount == -1) break; // all regime, no space for exponent or mantissa
@@ -223,81 +295,58 @@ class posit16_t {
     mantissa |= 0x8000; // add implied one;
   } // end of positSplit for posit16_t
 
-  // Posit16 methods for posit16 4 operations (+ - * /)
-  static posit16_t posit16_add(posit16_t a, posit16_t b) {
-    bool aSign, bSign, tempSign=0;
-    int8_t aExponent, bExponent, tempExponent;
-    uint16_t aMantissa, bMantissa, tempMantissa; // with leading one
-    uint8_t esBits;
-    int8_t bitCount = 14; // posit bit counter, start of regime
-    uint16_t tempResult = 0;
-
-    if (a.value == 0x8000 || b.value == 0x8000) return posit16_t((uint16_t) 0x8000); // NaR
-    if (a.value == 0) return b;
-    if (b.value == 0) return a;
-
-    positSplit(a, aSign, aExponent, aMantissa); // mantissas with leading 1
-    positSplit(b, bSign, bExponent, bMantissa);
-
-    // align smaller number (mantissa) with bigger number
-    if (aExponent > bExponent) bMantissa >>= (aExponent - bExponent);
-    if (aExponent < bExponent) aMantissa >>= (bExponent - aExponent);
-    tempExponent = max(aExponent, bExponent);
-    // TODO consider alternatives to avoid 32 bit arithmetic on AVR if possible
-    long longMantissa = (long) aMantissa + bMantissa; // Sign not treated here
-    if (aSign) {
-      longMantissa -= aMantissa;
-      longMantissa -= aMantissa; // written so to avoid unnecessary casts
+  // Operations on split posits (sign, 2's power, 16-bit mantissa with leading 1)
+  // Shared by posit16_t operations and mixed posit16_t/posit8_t operations,
+  // since a posit8_t mantissa is simply widened by adding zeros (<<8)
+  static posit16_t addParts(bool aSign, int8_t aExponent, uint16_t aMantissa,
+                            bool bSign, int8_t bExponent, uint16_t bMantissa) {
+    bool tempSign;
+    int8_t tempExponent;
+    uint16_t tempMantissa; // without leading one
+
+    // Only 16-bit arithmetic : 32-bit long operations cost twice as many instructions on AVR.
+    // The 3 or more mantissa bits below the 12 fraction bits of a posit16 are the guard bits,
+    // bits shifted out when aligning are dropped (results are truncated anyway).
+    if (aExponent < bExponent) { // swap, so that a is the number with bigger exponent
+      bool swapSign = aSign; aSign = bSign; bSign = swapSign;
+      int8_t swapExponent = aExponent; aExponent = bExponent; bExponent = swapExponent;
+      uint16_t swapMantissa = aMantissa; aMantissa = bMantissa; bMantissa = swapMantissa;
     }
-    if (bSign) {
-      longMantissa -= bMantissa;
-      longMantissa -= bMantissa;
-    }
-
-    // treat sign of result
-    if (longMantissa < 0) {
-      tempSign=1;
-      longMantissa = -longMantissa; // back to positive
-    }
-    if (longMantissa == 0) return posit16_t((uint16_t) 0); // could use EPSILON here ?
-
-    if (longMantissa > 0xFFFFL) tempExponent++; // one more power of two if sum carries over
-    else longMantissa <<= 1; // eliminate uncoded msb otherwise (same exponent or less)
-    while (longMantissa < (long) 65536) { // if msb not reached, in case of subtractions
-      // would be 32768 if there were no leading ones
-      //Serial.print("SmallMant ");
-      tempExponent--; // divide by two
-      longMantissa <<= 1;
+    uint8_t shift = aExponent - bExponent; // up to 112, posit16 exponents are between -56 and 56
+    bMantissa = (shift < 16) ? bMantissa >> shift : 0; // align smaller number (mantissa) with bigger number
+    tempExponent = aExponent;
+
+    if (aSign == bSign) { // addition of magnitudes, a has its leading one at bit15
+      tempSign = aSign;
+      tempMantissa = aMantissa + bMantissa;
+      if (tempMantissa < aMantissa) tempExponent++; // carry : leading one is bit16, lost, 16 bits stay
+      else tempMantissa <<= 1; // no carry : eliminate leading one at bit15
+    } else { // subtraction of magnitudes, result has the sign of the bigger one
+      if (aMantissa == bMantissa) return posit16_t((uint16_t) 0); // could use EPSILON here ?
+      if (aMantissa > bMantissa) {
+        tempSign = aSign;
+        tempMantissa = aMantissa - bMantissa;
+      } else { // only possible if both exponents are equal
+        tempSign = bSign;
+        tempMantissa = bMantissa - aMantissa;
+      }
+      uint8_t zeros = clz16(tempMantissa); // renormalize in one step
+      tempExponent -= zeros;
+      tempMantissa <<= zeros; // leading one at bit15
+      tempMantissa <<= 1; // eliminate it (two shifts, since shifting 16 bits at once is undefined)
     }
-    tempMantissa = longMantissa; // cast to 16bits
 #ifdef DEBUG
     //sprintf(s, "sexp=%02x mant=%05x ", tempExponent, tempMantissa); Serial.print(s);
 #endif
 
     return posit16_t(tempSign, tempExponent, tempMantissa);
-  } // end of posit16_add function definition
-
-  static posit16_t posit16_sub(posit16_t a, posit16_t b) {
-    b.value = -b.value; // 2's complement solves everything for us, 0 and NaR are conserved
-    return posit16_add(a, b);
-  }
-
-  static posit16_t posit16_mul(posit16_t a, posit16_t b) {
-    bool aSign, bSign, tempSign=0;
-    int8_t aExponent, bExponent, tempExponent;
-    uint16_t aMantissa, bMantissa, tempMantissa;
-    uint8_t esBits;
-    int8_t bitCount; // posit bit counter
-    uint16_t tempResult = 0;
+  } // end of addParts function definition
 
-    if ((a.value == 0 && b.value != 0x8000) || a.value == 0x8000) return a; // 0, NaR
-    if (b.value == 0 || b.value == 0x8000) return b;
-    if (a.value == 0x4000) return b;
-    if (b.value == 0x4000) return a;
-
-    // Split posit into constituents
-    positSplit(a, aSign, aExponent, aMantissa);
-    positSplit(b, bSign, bExponent, bMantissa); // Mantissas with leading 1
+  static posit16_t mulParts(bool aSign, int8_t aExponent, uint16_t aMantissa,
+                            bool bSign, int8_t bExponent, uint16_t bMantissa) {
+    bool tempSign;
+    int8_t tempExponent;
+    uint16_t tempMantissa;
 
     // xor signs, add exponents, multiply mantissas
     tempSign = (aSign ^ bSign); //tempResult = 0x8000;
@@ -323,24 +372,24 @@ class posit16_t {
     }
     tempMantissa = longMantissa ; // casting back to 16 bits
     return posit16_t(tempSign, tempExponent, tempMantissa);
-  } // end of posit16_mul function definition
+  } // end of mulParts function definition
 
-  static posit16_t posit16_div(posit16_t a, posit16_t b) {
-    bool aSign, bSign, tempSign;
-    int8_t aExponent, bExponent;
-    uint16_t aMantissa, bMantissa;
-    uint8_t esBits;
-    uint16_t tempResult = 0;
-
-    if (b.value == 0x8000 || b.value == 0) return posit16_t((uint16_t) 0x8000); // NaR if /0 or /NaR
-    if (a.value == 0 || a.value == 0x8000 || b.value == 0x4000) return a; // a==0 or NaR, b==1.0
-
-    positSplit(a, aSign, aExponent, aMantissa);
-    positSplit(b, bSign, bExponent, bMantissa); // with leading one
+  static posit16_t divParts(bool aSign, int8_t aExponent, uint16_t aMantissa,
+                            bool bSign, int8_t bExponent, uint16_t bMantissa) {
+    bool tempSign;
 
     // xor signs, sub exponents, div mantissas
     tempSign = (aSign ^ bSign) ;
     int tempExponent = (aExponent - bExponent);
+#ifdef POSIT_NO_FLOAT
+    // integer division of mantissas, 15 bits after leading one are more than posit16 needs
+    uint32_t quotient = ((uint32_t) aMantissa << 16) / bMantissa; // between 0.5 and 2, 16-bit fraction
+    if (quotient < 0x10000UL) { // below one
+      tempExponent--;
+      quotient <<= 1;
+    }
+    uint16_t tempMantissa = quotient; // eliminate leading one
+#else
     // first solution to divide mantissas : use float (not efficient)
     // TODO consider using fracdiv routine, like sqrt, or inverse and multiply
     union float_int { // for bit manipulation
@@ -355,9 +404,69 @@ class posit16_t {
     tempValue.tempInt <<= 1; // eliminate sign, byte-align exponent and mantissa
     uint16_t tempMantissa = tempValue.tempBytes[2] * 256 + tempValue.tempBytes[1]; // eliminate msb
     tempExponent += tempValue.tempBytes[3] - 127; // correct if necessary
+#endif
     return posit16_t(tempSign, tempExponent, tempMantissa);
+  } // end of divParts function definition
+
+  // Posit16 methods for posit16 4 operations (+ - * /)
+  static posit16_t posit16_add(posit16_t a, posit16_t b) {
+    bool aSign, bSign;
+    int8_t aExponent, bExponent;
+    uint16_t aMantissa, bMantissa; // with leading one
+
+    if (a.value == 0x8000 || b.value == 0x8000) return posit16_t((uint16_t) 0x8000); // NaR
+    if (a.value == 0) return b;
+    if (b.value == 0) return a;
+
+    positSplit(a, aSign, aExponent, aMantissa); // mantissas with leading 1
+    positSplit(b, bSign, bExponent, bMantissa);
+    return addParts(aSign, aExponent, aMantissa, bSign, bExponent, bMantissa);
+  } // end of posit16_add function definition
+
+  static posit16_t posit16_sub(posit16_t a, posit16_t b) {
+    b.value = -b.value; // 2's complement solves everything for us, 0 and NaR are conserved
+    return posit16_add(a, b);
+  }
+
+  static posit16_t posit16_mul(posit16_t a, posit16_t b) {
+    bool aSign, bSign;
+    int8_t aExponent, bExponent;
+    uint16_t aMantissa, bMantissa;
+
+    if ((a.value == 0 && b.value != 0x8000) || a.value == 0x8000) return a; // 0, NaR
+    if (b.value == 0 || b.value == 0x8000) return b;
+    if (a.value == 0x4000) return b;
+    if (b.value == 0x4000) return a;
+
+    // Split posit into constituents
+    positSplit(a, aSign, aExponent, aMantissa);
+    positSplit(b, bSign, bExponent, bMantissa); // Mantissas with leading 1
+    return mulParts(aSign, aExponent, aMantissa, bSign, bExponent, bMantissa);
+  } // end of posit16_mul function definition
+
+  static posit16_t posit16_div(posit16_t a, posit16_t b) {
+    bool aSign, bSign;
+    int8_t aExponent, bExponent;
+    uint16_t aMantissa, bMantissa;
+
+    if (b.value == 0x8000 || b.value == 0) return posit16_t((uint16_t) 0x8000); // NaR if /0 or /NaR
+    if (a.value == 0 || a.value == 0x8000 || b.value == 0x4000) return a; // a==0 or NaR, b==1.0
+
+    positSplit(a, aSign, aExponent, aMantissa);
+    positSplit(b, bSign, bExponent, bMantissa); // with leading one
+    return divParts(aSign, aExponent, aMantissa, bSign, bExponent, bMantissa);
   } // end of posit16_div function definition
 
+  // Mixed precision operations, posit8_t operands are split at their own width
+  // and the result is packed once as posit16_t (defined after posit8_t class)
+  static posit16_t posit16_add(posit16_t a, posit8_t b);
+  static posit16_t posit16_sub(posit16_t a, posit8_t b);
+  static posit16_t posit16_mul(posit16_t a, posit8_t b);
+  static posit16_t posit16_div(posit16_t a, posit8_t b);
+  static posit16_t posit16_div(posit8_t a, posit16_t b);
+  static posit16_t posit16_mul(posit8_t a, posit8_t b); // exact, 8x8 bits mantissa product fits
+  static posit16_t posit16_fma(posit16_t acc, posit8_t a, posit8_t b); // acc + a*b, one rounding
+
   // Operator overloading for Posit16
   posit16_t operator + (const posit16_t& other) const {
     return posit16_add(*this, other);
@@ -371,6 +480,9 @@ class posit16_t {
   posit16_t operator / (const posit16_t& other) const {
     return posit16_div(*this, other);
   }
+  constexpr posit16_t operator - () const { // negation, 2's complement keeps 0 and NaR
+    return posit16_t((uint16_t) -value);
+  }
   posit16_t& operator += (const posit16_t& other) {
   *this= posit16_add(*this, other);
   return *this;
@@ -414,8 +526,8 @@ static posit16_t posit16_sqrt(posit16_t& a) {
   int8_t aExponent, tempExponent;
   uint16_t aMantissa, tempMantissa;
 
-  if (a.value > 0x7FFF) return posit16_t(0x8000); // NaR for negative and NaR
-  if (a.value == 0) return posit16_t(0); // Newton-Raphson would /0
+  if (a.value > 0x7FFF) return posit16_t((uint16_t)0x8000); // NaR for negative and NaR
+  if (a.value == 0) return a; // Newton-Raphson would /0
     
   posit16_t::positSplit(a, aSign, aExponent, aMantissa);
   tempExponent = aExponent >>1; // exponent sqrt = exponent square/2
@@ -452,8 +564,14 @@ static posit16_t posit16_sqrt(posit16_t& a) {
   return posit16_t(aSign,tempExponent,tempMantissa);
 }
 
+// Raw constants, so that no conversion runs on each call (2 = 0x4800, 3 = 0x4C00).
+// Outside NOTRIG : add-on headers use them too.
+#define POSIT16_ONE posit16_t((uint16_t)0x4000)
+#define POSIT16_TWO posit16_t((uint16_t)0x4800)
+#define POSIT16_THREE posit16_t((uint16_t)0x4C00)
+
 #ifndef NOTRIG
-posit16_t Pi16 = 3.141602; // closest value
+posit16_t Pi16 = (uint16_t)0x4C91; // =3.141602, closest value
 posit16_t HalfPi16 = (uint16_t)0x4491; //=1.57079633+.00000445;
 
 static posit16_t posit16_sin(posit16_t& a) {
@@ -467,28 +585,28 @@ static posit16_t posit16_sin(posit16_t& a) {
   // First implementation using Taylor : sin x = x - x^3/6 = x/3 * (3-x^2/2) // more precise?
   // TODO second iteration : average with cos (PI/2-x) =  1 - x^2/2 is some range ?
   // TODO create posit<x>_half routines for posit16_t and posit8_t /2 (exponent--)
-  posit16_t aHalfSquare = a*(a/2);
-  posit16_t tempResult = (a/3)*((posit16_t)3-aHalfSquare);
+  posit16_t aHalfSquare = a*(a/POSIT16_TWO);
+  posit16_t tempResult = (a/POSIT16_THREE)*(POSIT16_THREE-aHalfSquare);
   return tempResult;
 }
 
 static posit16_t posit16_cos(posit16_t& a) {
   // First implementation using Taylor : cos x = 1 - x^2/2
-  posit16_t tempResult = (posit16_t)1- a*(a/2);
+  posit16_t tempResult = POSIT16_ONE- a*(a/POSIT16_TWO);
   return tempResult;
 }
 
 static posit16_t posit16_tan(posit16_t& a) {
   // first iteration : tan x = x + x^3/3 = x/3 * (3+x^2) // more precise?
   posit16_t aSquare = a*a;
-  posit16_t tempResult = (a/3)*((posit16_t)3+aSquare);
+  posit16_t tempResult = (a/POSIT16_THREE)*(POSIT16_THREE+aSquare);
   return tempResult;
 }
 
 static posit16_t posit16_atan(posit16_t& a) {
   // first iteration : atan x = x - x^3/3 = x/3 * (3-x^2)
   posit16_t aSquare = a*a;
-  posit16_t tempResult = (a/3)*((posit16_t)3-aSquare);
+  posit16_t tempResult = (a/POSIT16_THREE)*(POSIT16_THREE-aSquare);
   return tempResult;
 }
 #endif
@@ -524,17 +642,17 @@ class posit8_t { // Class definition
   uint8_t value; // tried int8_t as sign is msb, but nar to nan conversion bugged
                  // Still with 2's complement, int8_t should be possible/better
 
-  posit8_t(uint8_t raw = 0): value(raw) {} // Construct from raw unsigned byte
+  constexpr posit8_t(uint8_t raw = 0): value(raw) {} // Construct from raw unsigned byte, default constructor
  
   #ifdef byte // Exists in Arduino, but not in all C/C++ toolchains
       posit8_t(byte raw = 0): value(raw) {}  { // Construct from raw byte type (unsigned char)
   #endif //*/
   
-  posit8_t(posit16_t v=0) { // casting from posit16_t to posit8_t
+  posit8_t(posit16_t v) { // casting from posit16_t to posit8_t
     this->value = (v.value & 128) ? (v.value >> 8) : (v.value >> 8)+1-2*(v.value<0); // first try at rounding
   }
 
-  posit8_t(bool& tempSign, int8_t tempExponent, uint8_t& tempMantissa) {
+  POSIT_CONSTEXPR posit8_t(bool& tempSign, int8_t tempExponent, uint8_t& tempMantissa): value(0) {
     int8_t bitCount = 6; // first regime bit for Posit8
 #ifdef DEBUG
     /*Serial.print(tempSign?"-1.":"+1.");
@@ -553,7 +671,8 @@ class posit8_t { // Class definition
       bitCount--; // skip terminating (zero) bit
     } else { // abs(v) < 1, regime bits are zero
       while (tempExponent++ < 0 && bitCount--> 0); // do nothing, bits are already zero
-      this->value |= (1 << bitCount--); // mark terminating bit as 1
+      if (bitCount >= 0) this->value |= (1 << bitCount); // mark terminating bit as 1, none if underflow
+      bitCount--;
     }
 
     if (bitCount >= 0 && ES8 == 2) { // still space for exp msb (2^2=4)
@@ -577,58 +696,72 @@ class posit8_t { // Class definition
     //Serial.print(" ("); Serial.print(this->value,BIN); Serial.print(") ");
   }
 
-  posit8_t(float v = 0) { // Construct from float32, IEEE754 format
-    union float_int { // for bit manipulation
-      float tempFloat; // little-endian in AVR8
-      uint32_t tempInt; // little-endian as well
-      uint8_t tempBytes[4]; // [3] includes sign and exponent MSBs
-    } tempValue;
-    bool tempSign=0;
+  POSIT_CONSTEXPR_FLOAT posit8_t(float v): value(0) { // Construct from float32, IEEE754 format
+    // only bit manipulations, positive floats are ordered like integers
+    uint32_t bits = floatBits(v);
+    bool tempSign = bits >> 31;
 
-    this->value = 0;
-    if (v < 0) { // negative numbers
-      if (v >= -EPSILON) return; // very small neg numbers ~=0, non-standard
-      tempSign=true;
-      this->value += 0x80; // set sign and continue
-    } else { // v>=0
-      if (v <= EPSILON) return; // including EPSILON is required as EPSILON can be zero
-    }
-    if (isnan(v)) {
+    bits <<= 1; // eliminate sign, byte-align exponent and mantissa
+    if (bits <= floatBits(EPSILON) << 1) return; // zero or very small, non-standard
+    if (bits > 0xFF000000UL) { // NaN
       this->value = 0x80; // NaR
       return;
     }
-
-    tempValue.tempFloat = v;
-    tempValue.tempInt <<= 1; // eliminate sign, byte-align exponent and mantissa
-    int8_t tempExponent = tempValue.tempBytes[3] - 127; // remove IEEE754 bias
-    uint8_t tempMantissa = tempValue.tempBytes[2];
+    int8_t tempExponent = (uint8_t)(bits >> 24) - 127; // remove IEEE754 bias
+    uint8_t tempMantissa = bits >> 16;
 
     this->value = posit8_t(tempSign, tempExponent, tempMantissa).value;
   }
 
-  posit8_t(double v = 0.0) { // Construct from double by casting to float
-    this -> value = posit8_t((float) v).value;
+#if defined(POSIT_NO_FLOAT) && __SIZEOF_DOUBLE__ == 8
+  POSIT_CONSTEXPR_FLOAT posit8_t(double v): value(0) { // Construct from float64 bits, casting to float would use soft-float
+    if ((doubleBits(v) & 0x7FFFFFFFFFFFFFFFULL) <= doubleBits(EPSILON)) return; // zero or very small
+    this->value = truncate16(posit16_t(v));
   }
+#else
+  POSIT_CONSTEXPR_FLOAT posit8_t(double v): posit8_t((float) v) {} // Construct from double by casting to float
+#endif
 
-  posit8_t(int v = 0) { // Construct from int by casting to float for simplicity
-    this->value = posit8_t((float) v).value; // Now casting to float for simplicity
+  POSIT_CONSTEXPR posit8_t(int v): value(0) { // Construct from int without float : get log2(N), then extract mantissa
+    bool sign = v < 0;
+    unsigned int magnitude = sign ? -(unsigned int)v : v;
+    int8_t powerof2 = -1;
+    uint8_t mantissa = 0;
+
+    if (v == 0) return;
+    for (unsigned int rest = magnitude; rest; rest >>= 1) powerof2++;
+    // 8 bits after leading one are enough, posit8_t never keeps more than 5
+    if (powerof2 <= 8) mantissa = magnitude << (8 - powerof2);
+    else mantissa = magnitude >> (powerof2 - 8);
+    this->value = posit8_t(sign, powerof2, mantissa).value;
+  }
+
+  // Raw posit8_t value of a posit16_t, rounded towards zero (whatever ES8)
+  static POSIT_CONSTEXPR uint8_t truncate16(posit16_t p) {
+    bool tempSign = 0;
+    int8_t tempExponent = 0;
+    uint16_t tempMantissa = 0;
+
+    if (p.value == 0 || p.value == 0x8000) return p.value >> 8; // zero, NaR
+    posit16_t::positSplit(p, tempSign, tempExponent, tempMantissa);
+    uint8_t mantissa8 = tempMantissa >> 7; // eliminate leading one
+    return posit8_t(tempSign, tempExponent, mantissa8).value;
   }
   // End of constructors
 
   // Helper method to split a posit into constituents
   // arguments by reference to write to as result
-  static void positSplit(posit8_t p, bool& tempSign, int8_t& exponent, uint8_t& mantissa) {
-    bool bigNum; // true for abs(p)>=1
+  static POSIT_CONSTEXPR void positSplit(posit8_t p, bool& tempSign, int8_t& exponent, uint8_t& mantissa) {
     int8_t bitCount=5; // posit bit counter for regime, exp and mantissa
  
     tempSign = (p.value & 0x80);
     if(tempSign) p.value = -p.value;
     exponent = -(1 << ES8); // negative exponents start at -1/-2/-4;
-    bigNum = (p.value >= 0x40 && p.value < 0xC0);
+    bool bigNum = (p.value >= 0x40 && p.value < 0xC0); // true for abs(p)>=1
     if (bigNum) exponent = 0; // positive exponents start at 0
 
     //first extract exponent from regime bits
-    while ((p.value & (1 << bitCount)) == ((bigNum) << bitCount--)) { // still regime
+    while (((p.value >> bitCount--) & 1) == bigNum) { // still regime
       if (bigNum) exponent += 1 << ES8;
       else exponent -= 1 << ES8; // add/sub 2^es for each bit in regime
       if (bitCount == -1) break; // regime fills all bits, no space for exponent or mantissa
@@ -654,6 +787,15 @@ class posit8_t { // Class definition
 #endif
   } // end of positSplit
 
+#if ES8 == 0
+  // With ES8 = 0, posits in [-1,1] are a fixed-point grid with 6 fraction bits (Q1.6) :
+  // the raw value of x is x * 64, from -64 (0xC0) to 64 (0x40). Additions and products
+  // staying in that range are plain integer operations, with the same truncation.
+  static bool posit8Linear(posit8_t a) {
+    return (uint8_t)(a.value + 64) <= 128; // -64 to 64, NaR excluded
+  }
+#endif
+
   // Methods for posit8 arithmetic
   static posit8_t posit8_add(posit8_t a, posit8_t b) {
     bool aSign, bSign, tempSign=0;
@@ -662,6 +804,12 @@ class posit8_t { // Class definition
     int8_t bitCount; // posit bit counter
     uint8_t tempResult = 0;
 
+#if ES8 == 0
+    if (posit8Linear(a) && posit8Linear(b)) { // raw values are the fixed-point values
+      int8_t sum = (int8_t) a.value + (int8_t) b.value; // 128 wraps to -128, out of range as well
+      if (sum >= -64 && sum <= 64) return posit8_t((uint8_t) sum); // exact
+    }
+#endif
     if (a.value == 0x80 || b.value == 0x80) return posit8_t((uint8_t) 0x80); // NaR
     if (a.value == 0) return b;
     if (b.value == 0) return a;
@@ -717,6 +865,12 @@ class posit8_t { // Class definition
     int8_t bitCount;
     uint8_t tempResult = 0;
 
+#if ES8 == 0
+    if (posit8Linear(a) && posit8Linear(b)) { // product stays in [-1,1]
+      int16_t product = (int8_t) a.value * (int8_t) b.value; // 12 fraction bits
+      return posit8_t((uint8_t)(product / 64)); // back to 6 fraction bits, truncated toward zero
+    }
+#endif
     if ((a.value == 0 && b.value != 0x80) || a.value == 0x80) return a; // 0, /0, NaR
     if (b.value == 0 || b.value == 0x80) return b; // 0, NaR
     if (a.value == 0x40) return b; // 1*b
@@ -770,6 +924,15 @@ class posit8_t { // Class definition
     // xor signs, sub exponents, div mantissas
     if (aSign ^ bSign) tempSign = true ; // tempResult = 0x80;
     int tempExponent = (aExponent - bExponent);
+#ifdef POSIT_NO_FLOAT
+    // integer division of mantissas, 16-bit only
+    uint16_t quotient = ((uint16_t) aMantissa << 8) / bMantissa; // between 0.5 and 2, 8-bit fraction
+    if (quotient < 0x100) { // below one
+      tempExponent--;
+      quotient <<= 1;
+    }
+    uint8_t tempMantissa = quotient; // eliminate leading one
+#else
     // first solution to divide mantissas : use float division (not efficient)
     union float_int { // for bit manipulation
       float tempFloat; // little endian in AVR8
@@ -782,6 +945,7 @@ class posit8_t { // Class definition
     tempValue.tempInt <<= 1; // eliminate sign, align exponent and mantissa
     uint8_t tempMantissa = tempValue.tempBytes[2]; // division mantissa is there
     tempExponent += tempValue.tempBytes[3] - 127; // either 0 or -1
+#endif
 #ifdef DEBUG
     //sprintf(s, " mant=%02x ", tempMantissa); Serial.print(s);
     /*sprintf(s, "aexp=%02x mant=%02x ", aExponent, aMantissa); Serial.print(s);
@@ -793,7 +957,7 @@ class posit8_t { // Class definition
 
 static posit8_t posit8_sqrt(posit8_t& a) {
   if (a.value > 0x7F) return posit8_t((uint8_t)0x80); // NaR for negative and NaR
-  if (a.value == 0) return posit8_t(0); // Newton-Raphson would /0
+  if (a.value == 0) return a; // Newton-Raphson would /0
 
   posit8_t approx = a; // Initial approximation, OK for small regimes
   if ((a.value > 0x60) || (a.value < 0x1F)) { // Regime >= 2 bits
@@ -806,7 +970,7 @@ static posit8_t posit8_sqrt(posit8_t& a) {
     //Serial.print("Approx (");Serial.print(approx.value,BIN);
     //Serial.print("): ");Serial.println(posit2float(approx)); //*/
   }
-  posit8_t half = posit8_t(0.5); // using float constructor, value varies with ES8
+  posit8_t half = posit8_t((uint8_t)(0x40 - (0x40 >> (ES8 + 1)))); // 0.5 is 0x20, 0x30 or 0x38 with ES8
   
   // Newton-raphson iterations (not converging for 100 !)
   for (int8_t iter=0; iter<9; iter++) {
@@ -824,6 +988,11 @@ static posit8_t posit8_sqrt(posit8_t& a) {
   return approx;
 }
 
+// Raw constants, exponent and mantissa bits move right with ES8 (3 = 0x68, 0x58 or 0x4C)
+#define POSIT8_ONE posit8_t((uint8_t)0x40)
+#define POSIT8_TWO posit8_t((uint8_t)(0x40 | (0x20 >> ES8)))
+#define POSIT8_THREE posit8_t((uint8_t)(0x40 | (0x20 >> ES8) | (ES8 ? 0x10 >> ES8 : 0x08)))
+
 #ifndef NOTRIG
 // Formulas from https://en.wikipedia.org/wiki/Taylor_series#Trigonometric_functions
 //static const posit8_t Pi8 = posit8_t((uint8_t)0x4D); // 3.25 better than 3 since rounding goes down
@@ -831,28 +1000,28 @@ static posit8_t posit8_sqrt(posit8_t& a) {
 
 static posit8_t posit8_sin(posit8_t& a) {
   // first iteration : sin x = x - x^3/6 = x/3 * (3-x^2/2) // TODO check smaller error
-  posit8_t aHalfSquare = a*(a/2);
-  posit8_t tempResult = (a/3)*((posit8_t)3-aHalfSquare);
+  posit8_t aHalfSquare = a*(a/POSIT8_TWO);
+  posit8_t tempResult = (a/POSIT8_THREE)*(POSIT8_THREE-aHalfSquare);
   return tempResult;
 }
 
 static posit8_t posit8_cos(posit8_t& a) {
   // first iteration : cos x = 1 - x^2/2
-  posit8_t tempResult = (posit8_t)1- a*(a/2);
+  posit8_t tempResult = POSIT8_ONE- a*(a/POSIT8_TWO);
   return tempResult;
 }
 
 static posit8_t posit8_tan(posit8_t& a) {
   // first iteration : tan x = x + x^3/3 = x/3 * (3+x^2)
   posit8_t aSquare = a*a;
-  posit8_t tempResult = (a/3)*((posit8_t)3+aSquare);
+  posit8_t tempResult = (a/POSIT8_THREE)*(POSIT8_THREE+aSquare);
   return tempResult;
 }
 
 static posit8_t posit8_atan(posit8_t& a) {
   // first iteration : atan x = x - x^3/3 = x/3 * (3-x^2)
   posit8_t aSquare = a*a;
-  posit8_t tempResult = (a/3)*((posit8_t)3-aSquare);
+  posit8_t tempResult = (a/POSIT8_THREE)*(POSIT8_THREE-aSquare);
   return tempResult;
 }
 #endif // NOTRIG
@@ -896,6 +1065,9 @@ static posit8_t posit8_sign(posit8_t a) {
   posit8_t operator / (const posit8_t& other) const {
     return posit8_div(*this, other);
   }
+  constexpr posit8_t operator - () const { // negation, 2's complement keeps 0 and NaR
+    return posit8_t((uint8_t) -value);
+  }
   posit8_t& operator += (const posit8_t& other) {
   *this= posit8_add(*this, other);
   return *this;
@@ -914,8 +1086,457 @@ static posit8_t posit8_sign(posit8_t a) {
   }
 }; // end of posit8_t Class definition
 
+// Split a posit8_t into posit16_t parts : same power of 2, mantissa widened by adding zeros
+static void posit8Split16(posit8_t p, bool& sign, int8_t& powerof2, uint16_t& mantissa) {
+  uint8_t mantissa8;
+  posit8_t::positSplit(p, sign, powerof2, mantissa8);
+  mantissa = (uint16_t)mantissa8 << 8;
+}
+
 posit16_t::posit16_t(posit8_t a) { // Definition of posit8_t casting to posit16_t
-  this->value = (uint16_t)(a.value<<8);
+#if ES8==ES16
+  this->value = (uint16_t)(a.value<<8); // simply adding zeros
+#else
+  bool sign;
+  int8_t powerof2;
+  uint16_t mantissa;
+
+  this->value = (uint16_t)(a.value<<8); // correct for zero and NaR
+  if (a.value == 0 || a.value == 0x80) return;
+  posit8Split16(a, sign, powerof2, mantissa);
+  mantissa <<= 1; // eliminate leading one
+  this->value = posit16_t(sign, powerof2, mantissa).value;
+#endif
+}
+
+// Mixed precision posit16_t and posit8_t operations
+posit16_t posit16_t::posit16_add(posit16_t a, posit8_t b) {
+  bool aSign, bSign;
+  int8_t aExponent, bExponent;
+  uint16_t aMantissa, bMantissa;
+
+  if (a.value == 0x8000 || b.value == 0x80) return posit16_t((uint16_t) 0x8000); // NaR
+  if (b.value == 0) return a;
+  if (a.value == 0) return posit16_t(b);
+
+  positSplit(a, aSign, aExponent, aMantissa);
+  posit8Split16(b, bSign, bExponent, bMantissa);
+  return addParts(aSign, aExponent, aMantissa, bSign, bExponent, bMantissa);
+}
+
+posit16_t posit16_t::posit16_sub(posit16_t a, posit8_t b) {
+  b.value = -b.value; // 2's complement, 0 and NaR are conserved
+  return posit16_add(a, b);
+}
+
+posit16_t posit16_t::posit16_mul(posit16_t a, posit8_t b) {
+  bool aSign, bSign;
+  int8_t aExponent, bExponent;
+  uint16_t aMantissa, bMantissa;
+
+  if (a.value == 0x8000 || b.value == 0x80) return posit16_t((uint16_t) 0x8000); // NaR
+  if (a.value == 0 || b.value == 0) return posit16_t((uint16_t) 0);
+  if (b.value == 0x40) return a; // a*1
+
+  positSplit(a, aSign, aExponent, aMantissa);
+  posit8Split16(b, bSign, bExponent, bMantissa);
+  return mulParts(aSign, aExponent, aMantissa, bSign, bExponent, bMantissa);
+}
+
+posit16_t posit16_t::posit16_div(posit16_t a, posit8_t b) {
+  bool aSign, bSign;
+  int8_t aExponent, bExponent;
+  uint16_t aMantissa, bMantissa;
+
+  if (b.value == 0x80 || b.value == 0) return posit16_t((uint16_t) 0x8000); // NaR if /0 or /NaR
+  if (a.value == 0 || a.value == 0x8000 || b.value == 0x40) return a; // a==0 or NaR, b==1.0
+
+  positSplit(a, aSign, aExponent, aMantissa);
+  posit8Split16(b, bSign, bExponent, bMantissa);
+  return divParts(aSign, aExponent, aMantissa, bSign, bExponent, bMantissa);
+}
+
+posit16_t posit16_t::posit16_div(posit8_t a, posit16_t b) {
+  bool aSign, bSign;
+  int8_t aExponent, bExponent;
+  uint16_t aMantissa, bMantissa;
+
+  if (b.value == 0x8000 || b.value == 0) return posit16_t((uint16_t) 0x8000); // NaR if /0 or /NaR
+  if (a.value == 0 || a.value == 0x80) return posit16_t(a); // a==0 or NaR
+
+  posit8Split16(a, aSign, aExponent, aMantissa);
+  positSplit(b, bSign, bExponent, bMantissa);
+  return divParts(aSign, aExponent, aMantissa, bSign, bExponent, bMantissa);
+}
+
+// Product of two posit8_t as posit16_t parts, exact since 8x8 bit mantissas fit in 16 bits
+static void posit8MulSplit16(posit8_t a, posit8_t b, bool& sign, int8_t& powerof2, uint16_t& mantissa) {
+  bool aSign, bSign;
+  int8_t aExponent, bExponent;
+  uint8_t aMantissa, bMantissa;
+
+  posit8_t::positSplit(a, aSign, aExponent, aMantissa);
+  posit8_t::positSplit(b, bSign, bExponent, bMantissa);
+  sign = aSign ^ bSign;
+  powerof2 = aExponent + bExponent;
+  mantissa = (uint16_t)aMantissa * bMantissa; // 01xx.. or 1xxx.., leading one at bit 14 or 15
+  if (mantissa & 0x8000) powerof2++; // product is 2 or more
+  else mantissa <<= 1; // move leading one to bit 15
+}
+
+posit16_t posit16_t::posit16_mul(posit8_t a, posit8_t b) {
+  bool tempSign;
+  int8_t tempExponent;
+  uint16_t tempMantissa;
+
+  if (a.value == 0x80 || b.value == 0x80) return posit16_t((uint16_t) 0x8000); // NaR
+  if (a.value == 0 || b.value == 0) return posit16_t((uint16_t) 0);
+
+  posit8MulSplit16(a, b, tempSign, tempExponent, tempMantissa);
+  tempMantissa <<= 1; // eliminate leading one
+  return posit16_t(tempSign, tempExponent, tempMantissa);
+}
+
+posit16_t posit16_t::posit16_fma(posit16_t acc, posit8_t a, posit8_t b) {
+  bool accSign, tempSign;
+  int8_t accExponent, tempExponent;
+  uint16_t accMantissa, tempMantissa;
+
+  if (acc.value == 0x8000 || a.value == 0x80 || b.value == 0x80) return posit16_t((uint16_t) 0x8000); // NaR
+  if (a.value == 0 || b.value == 0) return acc;
+  if (acc.value == 0) return posit16_mul(a, b);
+
+  positSplit(acc, accSign, accExponent, accMantissa);
+  posit8MulSplit16(a, b, tempSign, tempExponent, tempMantissa); // product is never packed
+  return addParts(accSign, accExponent, accMantissa, tempSign, tempExponent, tempMantissa);
+}
+
+// Dot product of two posit8_t arrays accumulated in posit16_t, one rounding per element
+static inline posit16_t posit16_dot(const posit8_t* a, const posit8_t* b, uint16_t count, posit16_t acc = posit16_t((uint16_t)0)) {
+  for (uint16_t i = 0; i < count; i++) acc = posit16_t::posit16_fma(acc, a[i], b[i]);
+  return acc;
+}
+
+// Q1.6 fixed point (int8_t with 6 fraction bits, from -2 to 2 - 1/64) to posit8_t and back,
+// truncated. With ES8 = 0, [-1,1] has the very same bits in both formats.
+static posit8_t posit8_from_q6(int8_t q) {
+#if ES8 == 0
+  if (q >= -64 && q <= 64) return posit8_t((uint8_t) q);
+#endif
+  if (q == 0) return posit8_t((uint8_t)0);
+  bool sign = q < 0;
+  uint8_t magnitude = sign ? -q : q; // 1 to 128
+  uint8_t zeros = clz16(magnitude) - 8;
+  uint8_t mantissa = magnitude << (zeros + 1); // eliminate leading one
+  return posit8_t(sign, 1 - zeros, mantissa); // magnitude / 64
+}
+
+static int8_t posit8_to_q6(posit8_t p) { // saturates beyond the Q1.6 range, NaR gives -2 (same bits)
+#if ES8 == 0
+  if (posit8_t::posit8Linear(p)) return p.value;
+#endif
+  if (p.value == 0 || p.value == 0x80) return p.value;
+  bool sign;
+  int8_t powerof2;
+  uint8_t mantissa; // with leading one
+  posit8_t::positSplit(p, sign, powerof2, mantissa);
+  if (powerof2 >= 1) return sign ? -128 : 127;
+  if (powerof2 < -6) return 0;
+  uint8_t magnitude = mantissa >> (1 - powerof2);
+  return sign ? -magnitude : magnitude;
+}
+
+static inline void posit8_from_q6(const int8_t* in, posit8_t* out, uint16_t count) {
+  for (uint16_t i = 0; i < count; i++) out[i] = posit8_from_q6(in[i]);
+}
+static inline void posit8_to_q6(const posit8_t* in, int8_t* out, uint16_t count) {
+  for (uint16_t i = 0; i < count; i++) out[i] = posit8_to_q6(in[i]);
+}
+
+// Operator overloading for mixed posit16_t and posit8_t, results are posit16_t.
+// Template only used to match posit8_t exactly : int or float operands are still
+// converted to posit16_t by the class operators, without ambiguity
+template <typename T> struct posit8Operand {};
+template <> struct posit8Operand<posit8_t> { typedef posit16_t type; };
+
+template <typename T> typename posit8Operand<T>::type operator + (const posit16_t& a, const T& b) {
+  return posit16_t::posit16_add(a, b);
+}
+template <typename T> typename posit8Operand<T>::type operator + (const T& a, const posit16_t& b) {
+  return posit16_t::posit16_add(b, a);
+}
+template <typename T> typename posit8Operand<T>::type operator - (const posit16_t& a, const T& b) {
+  return posit16_t::posit16_sub(a, b);
+}
+template <typename T> typename posit8Operand<T>::type operator - (const T& a, const posit16_t& b) {
+  return posit16_t::posit16_add(posit16_t((uint16_t)-b.value), a); // -b + a
+}
+template <typename T> typename posit8Operand<T>::type operator * (const posit16_t& a, const T& b) {
+  return posit16_t::posit16_mul(a, b);
+}
+template <typename T> typename posit8Operand<T>::type operator * (const T& a, const posit16_t& b) {
+  return posit16_t::posit16_mul(b, a);
+}
+template <typename T> typename posit8Operand<T>::type operator / (const posit16_t& a, const T& b) {
+  return posit16_t::posit16_div(a, b);
+}
+template <typename T> typename posit8Operand<T>::type operator / (const T& a, const posit16_t& b) {
+  return posit16_t::posit16_div(a, b);
+}
+template <typename T> typename posit8Operand<T>::type& operator += (posit16_t& a, const T& b) {
+  a = posit16_t::posit16_add(a, b);
+  return a;
+}
+template <typename T> typename posit8Operand<T>::type& operator -= (posit16_t& a, const T& b) {
+  a = posit16_t::posit16_sub(a, b);
+  return a;
+}
+template <typename T> typename posit8Operand<T>::type& operator *= (posit16_t& a, const T& b) {
+  a = posit16_t::posit16_mul(a, b);
+  return a;
+}
+template <typename T> typename posit8Operand<T>::type& operator /= (posit16_t& a, const T& b) {
+  a = posit16_t::posit16_div(a, b);
+  return a;
+}
+
+// Unpacked posit : sign, 2's power and 32-bit mantissa, kept decoded between operations.
+// Every posit operation decodes the regime of its operands and encodes the result again.
+// Iterative code (Newton loops, filters, trig kernels) can unpack its posits once, compute
+// with splitPosit operators and pack the result once with pack16() or pack8(). Each
+// operation only truncates the 32-bit mantissa, more than twice the posit16 precision.
+// 8 bytes instead of 2 : meant for working variables, keep tables in posit8_t/posit16_t.
+//   splitPosit x = splitPosit::unpack(a), half = 0.5_p16; // Newton loop for sqrt(a)
+//   for (uint8_t i = 0; i < 6; i++) x = (x + a / x) * half;
+//   posit16_t root = x.pack16();
+// Posits and ints convert implicitly (ints are exact), floats do not : use posits or
+// literals like 0.5_p16 for fractions.
+struct splitPosit {
+  bool nar;
+  bool sign;
+  int16_t powerof2; // 2's power, wider than int8_t since results may go beyond maxpos
+  uint32_t mantissa; // leading one at bit31, zero for zero
+
+  splitPosit(int v = 0): nar(false), sign(v < 0), powerof2(0), mantissa(0) { // exact, even for 32-bit int
+    if (v == 0) return;
+    uint32_t magnitude = sign ? -(uint32_t) v : (uint32_t) v;
+    uint8_t zeros = clz32(magnitude);
+    powerof2 = 31 - zeros;
+    mantissa = magnitude << zeros;
+  }
+  splitPosit(posit16_t p): nar(p.value == 0x8000), sign(false), powerof2(0), mantissa(0) {
+    if (p.value == 0 || nar) return;
+    int8_t tempExponent = 0;
+    uint16_t tempMantissa = 0;
+    posit16_t::positSplit(p, sign, tempExponent, tempMantissa);
+    powerof2 = tempExponent;
+    mantissa = (uint32_t) tempMantissa << 16;
+  }
+  splitPosit(posit8_t p): nar(p.value == 0x80), sign(false), powerof2(0), mantissa(0) {
+    if (p.value == 0 || nar) return;
+    int8_t tempExponent = 0;
+    uint8_t tempMantissa = 0;
+    posit8_t::positSplit(p, sign, tempExponent, tempMantissa);
+    powerof2 = tempExponent;
+    mantissa = (uint32_t) tempMantissa << 24;
+  }
+  splitPosit(double) = delete; // the int constructor would silently truncate fractions
+
+  static splitPosit unpack(posit16_t p) {
+    return splitPosit(p);
+  }
+  static splitPosit unpack(posit8_t p) {
+    return splitPosit(p);
+  }
+  static splitPosit NaR() {
+    splitPosit w;
+    w.nar = true;
+    return w;
+  }
+
+  int8_t packedPowerof2() const { // beyond +-120, saturates to maxpos or underflows to zero anyway
+    if (powerof2 > 120) return 120;
+    if (powerof2 < -120) return -120;
+    return powerof2;
+  }
+  posit16_t pack16() const { // truncated like a single posit16_t operation
+    if (nar) return posit16_t((uint16_t) 0x8000);
+    if (!mantissa) return posit16_t((uint16_t) 0);
+    bool tempSign = sign;
+    uint16_t tempMantissa = mantissa >> 15; // eliminate leading one
+    return posit16_t(tempSign, packedPowerof2(), tempMantissa);
+  }
+  posit8_t pack8() const {
+    if (nar) return posit8_t((uint8_t) 0x80);
+    if (!mantissa) return posit8_t((uint8_t) 0);
+    bool tempSign = sign;
+    uint8_t tempMantissa = mantissa >> 23; // eliminate leading one
+    return posit8_t(tempSign, packedPowerof2(), tempMantissa);
+  }
+
+  static splitPosit add(splitPosit a, splitPosit b) {
+    if (a.nar || b.nar) return NaR();
+    if (!a.mantissa) return b;
+    if (!b.mantissa) return a;
+    if (a.powerof2 < b.powerof2) { // a is the number with bigger exponent
+      splitPosit swap = a;
+      a = b;
+      b = swap;
+    }
+    uint16_t shift = a.powerof2 - b.powerof2;
+    uint32_t bMantissa = (shift < 32) ? b.mantissa >> shift : 0; // align with bigger number
+    bool sticky = (shift < 32) ? (bMantissa << shift) != b.mantissa : true; // bits shifted out
+
+    if (a.sign == b.sign) { // bits shifted out only make the sum truncated
+      uint32_t sum = a.mantissa + bMantissa;
+      if (sum < a.mantissa) { // carry, put it back as leading one
+        a.powerof2++;
+        sum = (sum >> 1) | 0x80000000UL;
+      }
+      a.mantissa = sum;
+      return a;
+    }
+    bMantissa += sticky; // subtract a bit more than b, so that the result is still truncated
+    if (a.mantissa == bMantissa) return splitPosit();
+    if (a.mantissa > bMantissa) a.mantissa -= bMantissa;
+    else { // only possible with equal exponents
+      a.sign = b.sign;
+      a.mantissa = bMantissa - a.mantissa;
+    }
+    uint8_t zeros = clz32(a.mantissa);
+    a.powerof2 -= zeros;
+    a.mantissa <<= zeros;
+    return a;
+  }
+
+  static splitPosit mul(splitPosit a, splitPosit b) {
+    if (a.nar || b.nar) return NaR();
+    if (!a.mantissa || !b.mantissa) return splitPosit();
+    // upper 32 bits of the 64-bit product with four 16x16 products, no 64-bit arithmetic
+    uint32_t aHigh = a.mantissa >> 16, aLow = a.mantissa & 0xFFFF;
+    uint32_t bHigh = b.mantissa >> 16, bLow = b.mantissa & 0xFFFF;
+    uint32_t cross1 = aHigh * bLow, cross2 = aLow * bHigh;
+    uint32_t middle = (cross1 & 0xFFFF) + (cross2 & 0xFFFF) + ((aLow * bLow) >> 16);
+    uint32_t product = aHigh * bHigh + (cross1 >> 16) + (cross2 >> 16) + (middle >> 16);
+
+    a.sign ^= b.sign;
+    a.powerof2 = clampPowerof2(a.powerof2 + b.powerof2);
+    if (product & 0x80000000UL) a.powerof2++; // 2 <= product of mantissas < 4
+    else product <<= 1;
+    a.mantissa = product;
+    return a;
+  }
+
+  static splitPosit div(splitPosit a, splitPosit b) {
+    if (a.nar || b.nar || !b.mantissa) return NaR(); // x/0 is NaR
+    if (!a.mantissa) return a;
+    // restoring division, one quotient bit per step, first bit is the integer part
+    uint32_t rest = a.mantissa >> 1, divisor = b.mantissa >> 1, quotient = 0;
+    for (uint8_t i = 0; i < 32; i++) {
+      quotient <<= 1;
+      if (rest >= divisor) {
+        rest -= divisor;
+        quotient |= 1;
+      }
+      rest <<= 1;
+    }
+    a.sign ^= b.sign;
+    a.powerof2 = clampPowerof2(a.powerof2 - b.powerof2);
+    if (!(quotient & 0x80000000UL)) { // a.mantissa < b.mantissa
+      a.powerof2--;
+      quotient <<= 1;
+    }
+    a.mantissa = quotient;
+    return a;
+  }
+
+  // Long loops of products could overflow powerof2, results are far beyond maxpos anyway
+  static int16_t clampPowerof2(int16_t powerof2) {
+    if (powerof2 > 0x3FFF) return 0x3FFF;
+    if (powerof2 < -0x3FFF) return -0x3FFF;
+    return powerof2;
+  }
+
+  // -1, 0 or 1 like posit bit patterns compared as integers : NaR is below all numbers
+  static int8_t compare(const splitPosit& a, const splitPosit& b) {
+    if (a.nar || b.nar) return b.nar - a.nar;
+    int8_t aSide = a.mantissa ? (a.sign ? -1 : 1) : 0; // negated zero keeps its sign bit
+    int8_t bSide = b.mantissa ? (b.sign ? -1 : 1) : 0;
+    if (aSide != bSide || aSide == 0) return (aSide > bSide) - (aSide < bSide);
+    int8_t magnitude = (a.powerof2 == b.powerof2)
+      ? (a.mantissa > b.mantissa) - (a.mantissa < b.mantissa)
+      : (a.powerof2 > b.powerof2) - (a.powerof2 < b.powerof2);
+    return aSide * magnitude;
+  }
+
+  // Operators as friends, so that posit16_t, posit8_t or int work on either side
+  splitPosit operator - () const { // zero and NaR have no sign anyway
+    splitPosit w = *this;
+    w.sign = !w.sign;
+    return w;
+  }
+  friend splitPosit operator + (const splitPosit& a, const splitPosit& b) {
+    return add(a, b);
+  }
+  friend splitPosit operator - (const splitPosit& a, const splitPosit& b) {
+    return add(a, -b);
+  }
+  friend splitPosit operator * (const splitPosit& a, const splitPosit& b) {
+    return mul(a, b);
+  }
+  friend splitPosit operator / (const splitPosit& a, const splitPosit& b) {
+    return div(a, b);
+  }
+  splitPosit& operator += (const splitPosit& other) {
+    *this = add(*this, other);
+    return *this;
+  }
+  splitPosit& operator -= (const splitPosit& other) {
+    *this = add(*this, -other);
+    return *this;
+  }
+  splitPosit& operator *= (const splitPosit& other) {
+    *this = mul(*this, other);
+    return *this;
+  }
+  splitPosit& operator /= (const splitPosit& other) {
+    *this = div(*this, other);
+    return *this;
+  }
+  friend bool operator == (const splitPosit& a, const splitPosit& b) {
+    return compare(a, b) == 0;
+  }
+  friend bool operator != (const splitPosit& a, const splitPosit& b) {
+    return compare(a, b) != 0;
+  }
+  friend bool operator < (const splitPosit& a, const splitPosit& b) {
+    return compare(a, b) < 0;
+  }
+  friend bool operator > (const splitPosit& a, const splitPosit& b) {
+    return compare(a, b) > 0;
+  }
+  friend bool operator <= (const splitPosit& a, const splitPosit& b) {
+    return compare(a, b) <= 0;
+  }
+  friend bool operator >= (const splitPosit& a, const splitPosit& b) {
+    return compare(a, b) >= 0;
+  }
+}; // end of splitPosit struct definition
+
+// User-defined literals : 3.14_p16 or 0.5_p8 give compile-time bit patterns with constexpr
+// constructors, -2_p8 uses the negation operator. Integers beyond 0x7FFF use the float
+// constructor, which only reads bits (no float arithmetic in the constructor itself).
+static inline POSIT_CONSTEXPR_FLOAT posit16_t operator"" _p16(long double v) {
+  return posit16_t((float) v);
+}
+static inline POSIT_CONSTEXPR_FLOAT posit16_t operator"" _p16(unsigned long long v) {
+  return v <= 0x7FFF ? posit16_t((int) v) : posit16_t((float) v);
+}
+static inline POSIT_CONSTEXPR_FLOAT posit8_t operator"" _p8(long double v) {
+  return posit8_t((float) v);
+}
+static inline POSIT_CONSTEXPR_FLOAT posit8_t operator"" _p8(unsigned long long v) {
+  return v <= 0x7FFF ? posit8_t((int) v) : posit8_t((float) v);
 }
 
 float posit2float(posit16_t p) {// Can't be by reference since value is modified
@@ -954,7 +1575,7 @@ float posit2float(posit16_t p) {// Can't be by reference since value is modified
   tempValue.tempBytes[1] = mantissa; // implied & 0xFF, LSB if any
   tempValue.tempBytes[0] = 0;
   tempValue.tempInt >>= 1; // unsigned shift left for IEEE format
-  if (tempSign) return -tempValue.tempFloat;
+  if (tempSign) tempValue.tempBytes[3] |= 0x80; // sign bit, without float negation
   return tempValue.tempFloat;
 } // end of posit2float 16-bit
 
@@ -998,8 +1619,9 @@ float posit2float(posit8_t p) {
   tempValue.tempBytes[1] = 0;
   tempValue.tempBytes[0] = 0;
   tempValue.tempInt >>= 1; // unsigned shift left for IEEE format
-  if (tempSign) return -tempValue.tempFloat;
+  if (tempSign) tempValue.tempBytes[3] |= 0x80; // sign bit, without float negation
   return tempValue.tempFloat;
 #endif
 } // end of posit2float 8-bit
 
+#endif // POSIT_H
@@ -0,0 +1,337 @@
+/*************************************************************************************
+
+Posit32 : posit<32,2> for 32-bit boards without FPU, for the Posit Library for Arduino
+
+  Posit.h sticks to 8 and 16 bits : on AVR, 32-bit posits would be as slow as the float
+  library, for precision that floats already provide. ESP32-C3, RP2040 and SAMD21 have
+  no FPU either, but they multiply 32x32 bits in one instruction and count leading zeros
+  cheaply : there, posit32_t kernels working on 64-bit intermediate mantissas compete with
+  soft-float, with up to 27 mantissa bits around one instead of 23 for floats.
+
+  Same interface as posit16_t :
+  - constructors from raw value, parts, int, float and double (bits only, no float math)
+  - + - * / with operators, posit32_sqrt(), posit2float(), _p32 literals
+  - comparison operators : posits are ordered like 2's complement integers (NaR lowest)
+  - posit32_t(posit16_t) and posit32_t(posit8_t) are exact, to16() and to8() truncate
+  Operators are friends, so posit16_t, posit8_t, int and float operands are widened on
+  either side : p16 * p32 gives a posit32_t.
+  Like the other sizes, results are truncated toward zero, saturate to maxpos and
+  underflow to zero. EPSILON is not applied to posit32_t.
+
+  Compiles on AVR too, but all kernels use 64-bit arithmetic : not recommended there.
+
+  Copyright (c) 2024-2025 Christophe Vermeulen, MIT license (see Posit.h)
+************************************************************************************/
+
+#ifndef POSIT32_H
+#define POSIT32_H
+
+#include "Posit.h"
+
+#define ES32 2 // same as posit16_t, so that posit16_t converts by adding zeros
+
+static uint8_t clz64(uint64_t x) { // x != 0
+  return (x >> 32) ? clz32(x >> 32) : 32 + clz32(x);
+}
+
+class posit32_t {
+  public:
+  uint32_t value;
+
+  constexpr posit32_t(uint32_t v = 0): value(v) {} // default constructor, raw from unsigned 32-bit value
+
+  // construct from parts (sign, 2's power and mantissa without leading 1, left-aligned)
+  POSIT_CONSTEXPR posit32_t(bool sign, int16_t powerof2, uint32_t mantissa): value(0) {
+    if (powerof2 < -(30 << ES32)) return; // below minpos, underflow to zero
+    if (powerof2 > (30 << ES32)) powerof2 = 30 << ES32; // maxpos, all regime bits
+
+    // Build the 63 bits after the sign bit in a 64-bit word, then keep the upper 31 :
+    // no loop, and the truncation of mantissa bits that don't fit is free
+    int8_t regime = powerof2 >> ES32; // floor, even for negative powers
+    uint8_t regimeLength = 0; // regime bits and terminating bit
+    uint64_t body = 0;
+    if (regime >= 0) { // regime+1 ones, then a zero
+      regimeLength = regime + 2;
+      body = ((1ULL << (regime + 1)) - 1) << (62 - regime);
+    } else { // -regime zeros, then a one
+      regimeLength = 1 - regime;
+      body = 1ULL << (62 + regime);
+    }
+    body |= (uint64_t)(powerof2 & ((1 << ES32) - 1)) << (63 - regimeLength - ES32);
+    body |= ((uint64_t) mantissa << (31 - ES32)) >> regimeLength;
+    this->value = body >> 32;
+    if (sign) this->value = -this->value; // 2's complement for negative numbers
+  }
+
+  POSIT_CONSTEXPR_FLOAT posit32_t(float v): value(0) { // Construct from float32, only bit manipulations
+    uint32_t bits = floatBits(v);
+    bool sign = bits >> 31;
+
+    bits <<= 1; // eliminate sign
+    if (bits == 0) return; // subnormals underflow in the parts constructor
+    if (bits > 0xFF000000UL) { // NaN
+      this->value = 0x80000000UL; // NaR
+      return;
+    }
+    int16_t exponent = (int16_t)(bits >> 24) - 127;
+    this->value = posit32_t(sign, exponent, bits << 8).value;
+  }
+
+#if __SIZEOF_DOUBLE__ == 8
+  POSIT_CONSTEXPR_FLOAT posit32_t(double v): value(0) { // Construct from float64 bits, more than posit32 precision
+    uint64_t bits = doubleBits(v);
+    bool sign = bits >> 63;
+
+    bits <<= 1; // eliminate sign
+    if (bits == 0) return;
+    if (bits > 0xFFE0000000000000ULL) { // NaN
+      this->value = 0x80000000UL; // NaR
+      return;
+    }
+    int16_t exponent = (int16_t)(bits >> 53) - 1023;
+    this->value = posit32_t(sign, exponent, (uint32_t)(bits >> 21)).value; // 32 msbs of 52-bit mantissa
+  }
+#else
+  POSIT_CONSTEXPR_FLOAT posit32_t(double v): posit32_t((float) v) {} // double is float32 on AVR
+#endif
+
+  POSIT_CONSTEXPR posit32_t(int v): value(0) { // Construct from int, exact up to 2^27
+    bool sign = v < 0;
+    unsigned int magnitude = sign ? -(unsigned int)v : v;
+    int8_t powerof2 = -1;
+
+    if (v == 0) return;
+    for (unsigned int rest = magnitude; rest; rest >>= 1) powerof2++;
+    uint32_t mantissa = (uint64_t) magnitude << (32 - powerof2); // eliminate leading one
+    this->value = posit32_t(sign, powerof2, mantissa).value;
+  }
+
+  constexpr posit32_t(posit16_t p): value((uint32_t) p.value << 16) {} // same ES, adding zeros is exact
+  posit32_t(posit8_t p): value((uint32_t) posit16_t(p).value << 16) {}
+  // End of constructors
+
+  posit16_t to16() const { // truncated toward zero, smaller than posit16 minpos gives zero
+    bool sign = value >> 31;
+    uint16_t result = (sign ? -value : value) >> 16; // NaR stays 0x8000
+    return posit16_t((uint16_t)(sign ? -result : result));
+  }
+  posit8_t to8() const {
+    return posit8_t((uint8_t) posit8_t::truncate16(to16())); // not posit8_t(posit16_t), which rounds up
+  }
+
+  static void positSplit(posit32_t p, bool& sign, int16_t& powerof2, uint32_t& mantissa) {
+    // Reads posit32_t (not zero nor NaR), writes sign, powerof2 and mantissa (leading 1 at bit 31)
+    sign = p.value >> 31;
+    uint32_t bits = (sign ? -p.value : p.value) << 1; // regime starts at bit 31, bit 0 is zero
+    bool bigNum = bits >> 31; // true for abs(p) >= 1
+    uint8_t regimeLength = clz32(bigNum ? ~bits : bits); // count of identical regime bits, never 32
+
+    powerof2 = (bigNum ? regimeLength - 1 : -regimeLength) * (1 << ES32);
+    uint32_t fields = (uint64_t) bits << (regimeLength + 1); // skip regime and terminating bit
+    powerof2 += fields >> (32 - ES32);
+    mantissa = 0x80000000UL | ((fields << ES32) >> 1);
+  }
+
+  // Operations on parts, mantissas with leading one at bit 31, results truncated
+  static posit32_t addParts(bool aSign, int16_t aExponent, uint32_t aMantissa,
+    bool bSign, int16_t bExponent, uint32_t bMantissa) {
+    if (aExponent < bExponent) { // a is the number with bigger exponent
+      bool tempSign = aSign;
+      int16_t tempExponent = aExponent;
+      uint32_t tempMantissa = aMantissa;
+      aSign = bSign; aExponent = bExponent; aMantissa = bMantissa;
+      bSign = tempSign; bExponent = tempExponent; bMantissa = tempMantissa;
+    }
+    // leading ones at bit 62 : room for the carry, and 31 extra bits when aligning b
+    uint16_t shift = aExponent - bExponent;
+    uint64_t aWide = (uint64_t) aMantissa << 31, bWide = (uint64_t) bMantissa << 31;
+    bool sticky = shift >= 63 || ((bWide >> shift) << shift) != bWide; // bits shifted out
+    bWide = (shift < 63) ? bWide >> shift : 0;
+
+    if (aSign == bSign) {
+      aWide += bWide; // bits shifted out only make the sum truncated
+      if (aWide >> 63) { // carry
+        aExponent++;
+        aWide >>= 1;
+      }
+    } else {
+      bWide += sticky; // subtract a bit more than b, so that the result is still truncated
+      if (aWide == bWide) return posit32_t((uint32_t) 0);
+      if (aWide > bWide) aWide -= bWide;
+      else { // only possible with equal exponents
+        aSign = bSign;
+        aWide = bWide - aWide;
+      }
+      uint8_t zeros = clz64(aWide) - 1; // back to bit 62
+      aExponent -= zeros;
+      aWide <<= zeros;
+    }
+    return posit32_t(aSign, aExponent, (uint32_t)(aWide >> 30)); // eliminate leading one
+  }
+
+  static posit32_t mulParts(bool aSign, int16_t aExponent, uint32_t aMantissa,
+    bool bSign, int16_t bExponent, uint32_t bMantissa) {
+    uint64_t product = (uint64_t) aMantissa * bMantissa; // single instruction on ARM and RISC-V
+    aExponent += bExponent;
+    if (product >> 63) aExponent++; // 2 <= product of mantissas < 4
+    else product <<= 1;
+    return posit32_t(aSign ^ bSign, aExponent, (uint32_t)(product >> 31)); // eliminate leading one
+  }
+
+  static posit32_t divParts(bool aSign, int16_t aExponent, uint32_t aMantissa,
+    bool bSign, int16_t bExponent, uint32_t bMantissa) {
+    uint64_t quotient = ((uint64_t) aMantissa << 32) / bMantissa; // leading one at bit 32 or 31
+    aExponent -= bExponent;
+    if (!(quotient >> 32)) { // aMantissa < bMantissa
+      aExponent--;
+      quotient <<= 1;
+    }
+    return posit32_t(aSign ^ bSign, aExponent, (uint32_t) quotient); // eliminate leading one
+  }
+
+  static posit32_t posit32_add(posit32_t a, posit32_t b) {
+    bool aSign, bSign;
+    int16_t aExponent, bExponent;
+    uint32_t aMantissa, bMantissa;
+
+    if (a.value == 0x80000000UL || b.value == 0x80000000UL) return posit32_t((uint32_t) 0x80000000UL); // NaR
+    if (a.value == 0) return b;
+    if (b.value == 0) return a;
+
+    positSplit(a, aSign, aExponent, aMantissa);
+    positSplit(b, bSign, bExponent, bMantissa);
+    return addParts(aSign, aExponent, aMantissa, bSign, bExponent, bMantissa);
+  }
+
+  static posit32_t posit32_sub(posit32_t a, posit32_t b) {
+    b.value = -b.value; // 2's complement, 0 and NaR are conserved
+    return posit32_add(a, b);
+  }
+
+  static posit32_t posit32_mul(posit32_t a, posit32_t b) {
+    bool aSign, bSign;
+    int16_t aExponent, bExponent;
+    uint32_t aMantissa, bMantissa;
+
+    if (a.value == 0x80000000UL || b.value == 0x80000000UL) return posit32_t((uint32_t) 0x80000000UL); // NaR
+    if (a.value == 0 || b.value == 0) return posit32_t((uint32_t) 0);
+
+    positSplit(a, aSign, aExponent, aMantissa);
+    positSplit(b, bSign, bExponent, bMantissa);
+    return mulParts(aSign, aExponent, aMantissa, bSign, bExponent, bMantissa);
+  }
+
+  static posit32_t posit32_div(posit32_t a, posit32_t b) {
+    bool aSign, bSign;
+    int16_t aExponent, bExponent;
+    uint32_t aMantissa, bMantissa;
+
+    if (a.value == 0x80000000UL || b.value == 0x80000000UL || b.value == 0) return posit32_t((uint32_t) 0x80000000UL); // NaR, x/0
+    if (a.value == 0) return a;
+
+    positSplit(a, aSign, aExponent, aMantissa);
+    positSplit(b, bSign, bExponent, bMantissa);
+    return divParts(aSign, aExponent, aMantissa, bSign, bExponent, bMantissa);
+  }
+
+  // Operator overloading for Posit32, as friends so that both sides are widened
+  friend posit32_t operator + (const posit32_t& a, const posit32_t& b) {
+    return posit32_add(a, b);
+  }
+  friend posit32_t operator - (const posit32_t& a, const posit32_t& b) {
+    return posit32_sub(a, b);
+  }
+  friend posit32_t operator * (const posit32_t& a, const posit32_t& b) {
+    return posit32_mul(a, b);
+  }
+  friend posit32_t operator / (const posit32_t& a, const posit32_t& b) {
+    return posit32_div(a, b);
+  }
+  constexpr posit32_t operator - () const { // negation, 2's complement keeps 0 and NaR
+    return posit32_t((uint32_t) -value);
+  }
+  posit32_t& operator += (const posit32_t& other) {
+    *this = posit32_add(*this, other);
+    return *this;
+  }
+  posit32_t& operator -= (const posit32_t& other) {
+    *this = posit32_sub(*this, other);
+    return *this;
+  }
+  posit32_t& operator *= (const posit32_t& other) {
+    *this = posit32_mul(*this, other);
+    return *this;
+  }
+  posit32_t& operator /= (const posit32_t& other) {
+    *this = posit32_div(*this, other);
+    return *this;
+  }
+
+  // Comparisons are integer comparisons of the bit patterns
+  friend constexpr bool operator == (const posit32_t& a, const posit32_t& b) {
+    return a.value == b.value;
+  }
+  friend constexpr bool operator != (const posit32_t& a, const posit32_t& b) {
+    return a.value != b.value;
+  }
+  friend constexpr bool operator < (const posit32_t& a, const posit32_t& b) {
+    return (int32_t) a.value < (int32_t) b.value;
+  }
+  friend constexpr bool operator > (const posit32_t& a, const posit32_t& b) {
+    return (int32_t) a.value > (int32_t) b.value;
+  }
+  friend constexpr bool operator <= (const posit32_t& a, const posit32_t& b) {
+    return (int32_t) a.value <= (int32_t) b.value;
+  }
+  friend constexpr bool operator >= (const posit32_t& a, const posit32_t& b) {
+    return (int32_t) a.value >= (int32_t) b.value;
+  }
+}; // end of posit32_t class definition
+
+static posit32_t posit32_sqrt(posit32_t a) {
+  bool aSign;
+  int16_t aExponent;
+  uint32_t aMantissa;
+
+  if (a.value > 0x7FFFFFFFUL) return posit32_t((uint32_t) 0x80000000UL); // NaR for negative and NaR
+  if (a.value == 0) return a;
+
+  posit32_t::positSplit(a, aSign, aExponent, aMantissa);
+  // mantissa 1.xxx as 2^62 fixed point (2^63 with odd powers of 2, carried down into the
+  // mantissa), so that the integer square root has its leading one at bit 31
+  uint64_t rest = (uint64_t) aMantissa << ((aExponent & 1) ? 32 : 31);
+  uint64_t root = 0;
+  for (uint64_t bit = 1ULL << 62; bit; bit >>= 2) { // one root bit per step, no division
+    if (rest >= root + bit) {
+      rest -= root + bit;
+      root = (root >> 1) + bit;
+    } else root >>= 1;
+  }
+  return posit32_t(false, aExponent >> 1, (uint32_t) root << 1); // eliminate leading one
+}
+
+static float posit2float(posit32_t p) { // truncated to 23 mantissa bits, posit32 range fits in floats
+  bool tempSign;
+  int16_t exponent;
+  uint32_t mantissa;
+  union float_int { // for bit manipulation
+    float tempFloat;
+    uint32_t tempInt;
+  } tempValue;
+
+  if (p.value == 0) return 0.0f;
+  if (p.value == 0x80000000UL) return NAN;
+  posit32_t::positSplit(p, tempSign, exponent, mantissa);
+  tempValue.tempInt = ((uint32_t) tempSign << 31) | ((uint32_t)(exponent + 127) << 23) | ((mantissa << 1) >> 9);
+  return tempValue.tempFloat;
+}
+
+// Literals like 3.14159265_p32, from double bits when double has 64 bits
+static inline POSIT_CONSTEXPR_FLOAT posit32_t operator"" _p32(long double v) {
+  return posit32_t((double) v);
+}
+static inline POSIT_CONSTEXPR_FLOAT posit32_t operator"" _p32(unsigned long long v) {
+  return v <= 0x7FFF ? posit32_t((int) v) : posit32_t((double) v);
+}
+
+#endif // POSIT32_H
@@ -0,0 +1,339 @@
+/*************************************************************************************
+
+PositActivation : neural network activations for the Posit Library for Arduino
+
+  Forward passes of small networks (DQN, actor-critic) apply an activation to each
+  neuron : sigmoid(posit2float(x)) costs two conversions and a float exp() per neuron.
+  These kernels work on the posit bits directly, no float at all :
+  - relu : negative posits have the sign bit set, NaR stays NaR
+  - sigmoid and tanh of posit8_t with ES8 = 0 : posit8,0 is a fixed-point number in
+    [0,1], so flipping the sign bit and shifting right by 2 gives an approximation of
+    sigmoid(x) (the fast sigmoid of Gustafson), and tanh(x) = 2 * sigmoid(2x) - 1
+    only takes another shift. Coarse (max error 0.06 for sigmoid, 0.13 for tanh) :
+    fine for hidden layers, where the next weights absorb a smooth distortion.
+  - sigmoid and tanh of posit8_t with ES8 = 1 or 2 : 256 bytes tables in flash,
+    indexed by the raw value (exact truncations)
+  - sigmoid and tanh of posit16_t : 1 KB fixed-point tables in flash, one point every
+    128 raw values of positive posits (symmetries give negative ones), interpolated
+    linearly (max error 4e-4 for sigmoid, 5.3e-4 for tanh near 1, at most 2 ulps for
+    values above 1/4)
+  - hard_swish(x) = x * relu6(x + 3) / 6 with one truncation, through splitPosit
+  Each function has a bulk version for arrays (in and out may be the same array).
+  Tables are generated by extras/host/ActivationTables.cpp.
+
+  Example (hidden layer) :
+    for (uint8_t i = 0; i < HIDDEN; i++) hidden[i] = posit16_dot(weights[i], input, INPUTS);
+    posit16_tanh(hidden, hidden, HIDDEN);
+
+  Copyright (c) 2024-2025 Christophe Vermeulen, MIT license (see Posit.h)
+************************************************************************************/
+
+#ifndef POSIT_ACTIVATION_H
+#define POSIT_ACTIVATION_H
+
+#include "Posit.h"
+
+// Generated by extras/host/ActivationTables.cpp
+#if ES8 == 1
+static const uint8_t positSigmoid8Table[256] PROGMEM = { // ES8 = 1, indexed by raw value
+  0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+  0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x31, 0x31, 0x31, 0x31, 0x31, 0x31, 0x31,
+  0x31, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+  0x33, 0x34, 0x34, 0x34, 0x34, 0x35, 0x35, 0x35, 0x35, 0x35, 0x36, 0x36, 0x36, 0x36, 0x36, 0x37,
+  0x37, 0x37, 0x38, 0x38, 0x38, 0x39, 0x39, 0x39, 0x3A, 0x3A, 0x3A, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B,
+  0x3C, 0x3C, 0x3C, 0x3D, 0x3D, 0x3D, 0x3E, 0x3E, 0x3E, 0x3E, 0x3E, 0x3E, 0x3F, 0x3F, 0x3F, 0x3F,
+  0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F,
+  0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F,
+  0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06,
+  0x08, 0x09, 0x09, 0x0A, 0x0B, 0x0C, 0x0C, 0x0D, 0x0E, 0x0E, 0x0F, 0x10, 0x11, 0x12, 0x14, 0x15,
+  0x17, 0x18, 0x18, 0x18, 0x19, 0x19, 0x1A, 0x1B, 0x1B, 0x1C, 0x1C, 0x1D, 0x1E, 0x1E, 0x1F, 0x20,
+  0x21, 0x21, 0x22, 0x22, 0x22, 0x23, 0x23, 0x24, 0x24, 0x24, 0x25, 0x25, 0x26, 0x26, 0x27, 0x27,
+  0x28, 0x28, 0x28, 0x28, 0x29, 0x29, 0x29, 0x29, 0x2A, 0x2A, 0x2A, 0x2A, 0x2B, 0x2B, 0x2B, 0x2B,
+  0x2C, 0x2C, 0x2C, 0x2C, 0x2D, 0x2D, 0x2D, 0x2D, 0x2E, 0x2E, 0x2E, 0x2E, 0x2E, 0x2E, 0x2E, 0x2E,
+  0x2F, 0x2F, 0x2F, 0x2F, 0x2F, 0x2F, 0x2F, 0x2F, 0x2F, 0x2F, 0x2F, 0x2F, 0x2F, 0x2F, 0x2F, 0x2F
+};
+static const uint8_t positTanh8Table[256] PROGMEM = { // ES8 = 1, indexed by raw value
+  0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+  0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E,
+  0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x2B, 0x2B, 0x2C,
+  0x2D, 0x2F, 0x30, 0x31, 0x31, 0x32, 0x33, 0x33, 0x34, 0x34, 0x35, 0x36, 0x36, 0x37, 0x37, 0x37,
+  0x38, 0x39, 0x39, 0x3A, 0x3B, 0x3B, 0x3C, 0x3C, 0x3C, 0x3D, 0x3D, 0x3D, 0x3E, 0x3E, 0x3E, 0x3E,
+  0x3E, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F,
+  0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F,
+  0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F,
+  0x80, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1,
+  0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1,
+  0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1,
+  0xC2, 0xC2, 0xC2, 0xC2, 0xC2, 0xC3, 0xC3, 0xC3, 0xC4, 0xC4, 0xC4, 0xC5, 0xC5, 0xC6, 0xC7, 0xC7,
+  0xC8, 0xC9, 0xC9, 0xC9, 0xCA, 0xCA, 0xCB, 0xCC, 0xCC, 0xCD, 0xCD, 0xCE, 0xCF, 0xCF, 0xD0, 0xD1,
+  0xD3, 0xD4, 0xD5, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9, 0xDA, 0xDA, 0xDB, 0xDC, 0xDD, 0xDE, 0xDF, 0xE0,
+  0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xEB, 0xEC, 0xED, 0xEE, 0xEF, 0xF0,
+  0xF1, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFB, 0xFC, 0xFD, 0xFE, 0xFF, 0x00
+};
+#elif ES8 == 2
+static const uint8_t positSigmoid8Table[256] PROGMEM = { // ES8 = 2, indexed by raw value
+  0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38,
+  0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38,
+  0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38,
+  0x38, 0x39, 0x39, 0x39, 0x39, 0x39, 0x39, 0x39, 0x39, 0x3A, 0x3A, 0x3A, 0x3A, 0x3B, 0x3B, 0x3B,
+  0x3B, 0x3C, 0x3C, 0x3C, 0x3D, 0x3D, 0x3D, 0x3D, 0x3E, 0x3E, 0x3E, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F,
+  0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F,
+  0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F,
+  0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F,
+  0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x01, 0x01, 0x01, 0x02, 0x03, 0x04, 0x05, 0x07, 0x08, 0x0A, 0x0B, 0x0D, 0x0E, 0x10, 0x12, 0x15,
+  0x18, 0x19, 0x1B, 0x1C, 0x1E, 0x1F, 0x21, 0x24, 0x27, 0x28, 0x29, 0x2A, 0x2B, 0x2C, 0x2E, 0x2F,
+  0x30, 0x31, 0x31, 0x31, 0x32, 0x32, 0x33, 0x33, 0x34, 0x34, 0x34, 0x34, 0x35, 0x35, 0x35, 0x35,
+  0x36, 0x36, 0x36, 0x36, 0x36, 0x36, 0x36, 0x36, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37,
+  0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37,
+  0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37
+};
+static const uint8_t positTanh8Table[256] PROGMEM = { // ES8 = 2, indexed by raw value
+  0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+  0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E,
+  0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E,
+  0x2F, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x35, 0x36, 0x38, 0x38, 0x39, 0x3A, 0x3A, 0x3B, 0x3B,
+  0x3C, 0x3C, 0x3D, 0x3E, 0x3E, 0x3E, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F,
+  0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F,
+  0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F,
+  0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F,
+  0x80, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1,
+  0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1,
+  0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1,
+  0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC2, 0xC2, 0xC2, 0xC3, 0xC4,
+  0xC4, 0xC5, 0xC5, 0xC6, 0xC6, 0xC7, 0xC8, 0xC8, 0xCA, 0xCB, 0xCB, 0xCC, 0xCD, 0xCE, 0xCF, 0xD0,
+  0xD1, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9, 0xDA, 0xDB, 0xDC, 0xDD, 0xDE, 0xDF, 0xE0,
+  0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xEB, 0xEC, 0xED, 0xEE, 0xEF, 0xF0,
+  0xF1, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFB, 0xFC, 0xFD, 0xFE, 0xFF, 0x00
+};
+#endif // ES8 == 0 uses bit tricks instead
+
+static const uint32_t positSigmoid16Table[257] PROGMEM = { // x = index << 7 as raw value
+  0x80000000UL, 0x7FFFFFFCUL, 0x7FFFFFC0UL, 0x7FFFFF00UL, 0x7FFFFC00UL, 0x7FFFF800UL,
+  0x7FFFF000UL, 0x7FFFE000UL, 0x7FFFC000UL, 0x7FFFA000UL, 0x7FFF8000UL, 0x7FFF4000UL,
+  0x7FFF0000UL, 0x7FFE8000UL, 0x7FFE0000UL, 0x7FFD0000UL, 0x7FFC0000UL, 0x7FFB0000UL,
+  0x7FFA0000UL, 0x7FF90000UL, 0x7FF80000UL, 0x7FF60000UL, 0x7FF40000UL, 0x7FF20000UL,
+  0x7FF00000UL, 0x7FEC0000UL, 0x7FE80000UL, 0x7FE40000UL, 0x7FE00000UL, 0x7FD80001UL,
+  0x7FD00002UL, 0x7FC80003UL, 0x7FC00005UL, 0x7FB80007UL, 0x7FB0000AUL, 0x7FA8000DUL,
+  0x7FA00011UL, 0x7F980016UL, 0x7F90001CUL, 0x7F880023UL, 0x7F80002AUL, 0x7F70003CUL,
+  0x7F600053UL, 0x7F50006EUL, 0x7F40008FUL, 0x7F3000B7UL, 0x7F2000E4UL, 0x7F100119UL,
+  0x7F000155UL, 0x7EE001E5UL, 0x7EC0029AUL, 0x7EA00377UL, 0x7E80047FUL, 0x7E6005B8UL,
+  0x7E400725UL, 0x7E2008C9UL, 0x7E000AAAUL, 0x7DC00F2FUL, 0x7D8014D4UL, 0x7D401BB9UL,
+  0x7D0023FDUL, 0x7CC02DC2UL, 0x7C803926UL, 0x7C404649UL, 0x7C00554CUL, 0x7BC0664FUL,
+  0x7B807970UL, 0x7B408ED1UL, 0x7B00A690UL, 0x7AC0C0CEUL, 0x7A80DDABUL, 0x7A40FD46UL,
+  0x7A011FBFUL, 0x79C14535UL, 0x79816DCAUL, 0x7941999BUL, 0x7901C8C9UL, 0x78C1FB73UL,
+  0x788231BAUL, 0x78426BBCUL, 0x7802A99AUL, 0x77833164UL, 0x7703CA14UL, 0x768474A7UL,
+  0x76053216UL, 0x7586035BUL, 0x7506E970UL, 0x7487E54EUL, 0x7408F7EDUL, 0x738A2245UL,
+  0x730B654CUL, 0x728CC1F8UL, 0x720E393EUL, 0x718FCC13UL, 0x71117B6AUL, 0x70934837UL,
+  0x7015336AUL, 0x6F1968C6UL, 0x6E1E22FAUL, 0x6D236971UL, 0x6C294384UL, 0x6B2FB87CUL,
+  0x6A36CF8DUL, 0x693E8FDAUL, 0x6847006FUL, 0x67502846UL, 0x665A0E41UL, 0x6564B92DUL,
+  0x64702FBEUL, 0x637C7893UL, 0x62899A30UL, 0x61979B01UL, 0x60A68159UL, 0x5EC71761UL,
+  0x5CEB8CC3UL, 0x5B14103CUL, 0x5940CEBEUL, 0x5771F35FUL, 0x55A7A753UL, 0x53E211DBUL,
+  0x52215842UL, 0x50659DD4UL, 0x4EAF03D6UL, 0x4CFDA989UL, 0x4B51AC23UL, 0x49AB26CDUL,
+  0x480A32A8UL, 0x466EE6CDUL, 0x44D95851UL, 0x41BFBDCBUL, 0x3EBDE434UL, 0x3BD42E07UL,
+  0x3902E055UL, 0x364A2423UL, 0x33AA0805UL, 0x312281D0UL, 0x2EB3706AUL, 0x2C5C9DA9UL,
+  0x2A1DC03BUL, 0x27F67D95UL, 0x25E66BD1UL, 0x23ED1392UL, 0x2209F1C7UL, 0x203C796CUL,
+  0x1E84152BUL, 0x1B501323UL, 0x1868D291UL, 0x15C90D0FUL, 0x136B7112UL, 0x114ABD6DUL,
+  0x0F61D6B5UL, 0x0DABD732UL, 0x0C241A1EUL, 0x0AC642E6UL, 0x098E4140UL, 0x0878529BUL,
+  0x078101A0UL, 0x06A52430UL, 0x05E1D84CUL, 0x05348048UL, 0x049ABE87UL, 0x0399AC82UL,
+  0x02D00A4FUL, 0x02322253UL, 0x01B69F67UL, 0x01561B2DUL, 0x010ABD94UL, 0x00CFECC9UL,
+  0x00A20BBBUL, 0x007E453EUL, 0x006261A8UL, 0x004CA520UL, 0x003BB4E7UL, 0x002E824BUL,
+  0x00243A16UL, 0x001C378CUL, 0x0015FA3DUL, 0x000D54F0UL, 0x00081637UL, 0x0004E7B6UL,
+  0x0002F9A6UL, 0x0001CDF8UL, 0x00011834UL, 0x0000A9F3UL, 0x00006715UL, 0x00003E85UL,
+  0x000025ECUL, 0x00001700UL, 0x00000DF3UL, 0x00000876UL, 0x00000521UL, 0x0000031CUL,
+  0x000001E3UL, 0x00000041UL, 0x00000008UL, 0x00000001UL, 0x00000000UL, 0x00000000UL,
+  0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+  0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+  0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+  0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+  0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+  0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+  0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+  0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+  0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+  0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL
+};
+static const uint32_t positTanh16Table[257] PROGMEM = { // x = index << 7 as raw value
+  0x00000000UL, 0x00000010UL, 0x000000FFUL, 0x000003FFUL, 0x00000FFFUL, 0x00001FFFUL,
+  0x00003FFFUL, 0x00007FFFUL, 0x0000FFFFUL, 0x00017FFFUL, 0x0001FFFFUL, 0x0002FFFFUL,
+  0x0003FFFFUL, 0x0005FFFFUL, 0x0007FFFFUL, 0x000BFFFFUL, 0x000FFFFFUL, 0x0013FFFFUL,
+  0x0017FFFFUL, 0x001BFFFFUL, 0x001FFFFFUL, 0x0027FFFFUL, 0x002FFFFFUL, 0x0037FFFFUL,
+  0x003FFFFEUL, 0x004FFFFDUL, 0x005FFFFBUL, 0x006FFFF8UL, 0x007FFFF5UL, 0x009FFFEBUL,
+  0x00BFFFDCUL, 0x00DFFFC6UL, 0x00FFFFAAUL, 0x011FFF86UL, 0x013FFF59UL, 0x015FFF22UL,
+  0x017FFEE0UL, 0x019FFE91UL, 0x01BFFE36UL, 0x01DFFDCDUL, 0x01FFFD55UL, 0x023FFC34UL,
+  0x027FFACAUL, 0x02BFF911UL, 0x02FFF700UL, 0x033FF48EUL, 0x037FF1B5UL, 0x03BFEE6CUL,
+  0x03FFEAABUL, 0x047FE1A0UL, 0x04FFD656UL, 0x057FC88DUL, 0x05FFB804UL, 0x067FA47BUL,
+  0x06FF8DB3UL, 0x077F736CUL, 0x07FF5566UL, 0x08FF0D1EUL, 0x09FEB2DEUL, 0x0AFE44A9UL,
+  0x0BFDC081UL, 0x0CFD246BUL, 0x0DFC6E6DUL, 0x0EFB9C8AUL, 0x0FFAACCBUL, 0x10F99D37UL,
+  0x11F86BD6UL, 0x12F716B1UL, 0x13F59BD3UL, 0x14F3F949UL, 0x15F22D1EUL, 0x16F03562UL,
+  0x17EE1024UL, 0x18EBBB75UL, 0x19E93567UL, 0x1AE67C0FUL, 0x1BE38D83UL, 0x1CE067D9UL,
+  0x1DDD092AUL, 0x1ED96F91UL, 0x1FD5992BUL, 0x21CD2E73UL, 0x23C3BA0AUL, 0x25B92D1CUL,
+  0x27AD78F6UL, 0x29A08F06UL, 0x2B9260E4UL, 0x2D82E04BUL, 0x2F71FF20UL, 0x315FAF72UL,
+  0x334BE37CUL, 0x35368DA5UL, 0x371FA082UL, 0x39070ED9UL, 0x3AECCB9FUL, 0x3CD0C9FCUL,
+  0x3EB2FD4DUL, 0x4271D13DUL, 0x4628E679UL, 0x49D7DF87UL, 0x4D7E6283UL, 0x511C1940UL,
+  0x54B0B158UL, 0x583BDC48UL, 0x5BBD4F7AUL, 0x5F34C457UL, 0x62A1F852UL, 0x6604ACECUL,
+  0x695CA7B9UL, 0x6CA9B264UL, 0x6FEB9AAEUL, 0x73223264UL, 0x764D4F5DUL, 0x7C808468UL,
+  0x82843797UL, 0x8857A3F0UL, 0x8DFA3F55UL, 0x936BB7B9UL, 0x98ABEFF4UL, 0x9DBAFC5EUL,
+  0xA2991F2AUL, 0xA746C4ADUL, 0xABC47F88UL, 0xB01304D5UL, 0xB433285CUL, 0xB825D8DBUL,
+  0xBBEC1C71UL, 0xBF870D26UL, 0xC2F7D5A8UL, 0xC95FD9B8UL, 0xCF2E5ADDUL, 0xD46DE5E1UL,
+  0xD9291DDBUL, 0xDD6A8525UL, 0xE13C5295UL, 0xE4A8519AUL, 0xE7B7CBC3UL, 0xEA737A32UL,
+  0xECE37D7FUL, 0xEF0F5AC9UL, 0xF0FDFCBFUL, 0xF2B5B79FUL, 0xF43C4F67UL, 0xF596FF6EUL,
+  0xF6CA82F0UL, 0xF8CCA6FBUL, 0xFA5FEB61UL, 0xFB9BBB59UL, 0xFC92C130UL, 0xFD53C9A5UL,
+  0xFDEA84D7UL, 0xFE60266DUL, 0xFEBBE888UL, 0xFF037583UL, 0xFF3B3CAEUL, 0xFF66B5BFUL,
+  0xFF889631UL, 0xFFA2FB69UL, 0xFFB78BD3UL, 0xFFC790E6UL, 0xFFD40B84UL, 0xFFE5561FUL,
+  0xFFEFD390UL, 0xFFF63093UL, 0xFFFA0CB3UL, 0xFFFC640EUL, 0xFFFDCF97UL, 0xFFFEAC18UL,
+  0xFFFF31D5UL, 0xFFFF82F4UL, 0xFFFFB427UL, 0xFFFFD1FFUL, 0xFFFFE419UL, 0xFFFFEF13UL,
+  0xFFFFF5BCUL, 0xFFFFF9C6UL, 0xFFFFFC39UL, 0xFFFFFE9CUL, 0xFFFFFF7DUL, 0xFFFFFFCFUL,
+  0xFFFFFFEEUL, 0xFFFFFFF9UL, 0xFFFFFFFDUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL,
+  0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL,
+  0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL,
+  0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL,
+  0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL,
+  0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL,
+  0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL,
+  0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL,
+  0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL,
+  0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL,
+  0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL,
+  0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL,
+  0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL
+};
+
+static posit8_t posit8_relu(posit8_t a) {
+  return (a.value > 0x80) ? posit8_t((uint8_t)0) : a; // sign bit set, but not NaR
+}
+static posit16_t posit16_relu(posit16_t a) {
+  return (a.value > 0x8000) ? posit16_t((uint16_t)0) : a;
+}
+
+#if ES8 == 0
+// Raw value of sigmoid(x) : posit8,0 values in [0,1] are raw/64, and sigmoid(x) is close
+// to (raw(x) + 128) / 256 over the whole posit range
+static uint8_t posit8SigmoidRaw(uint8_t raw) {
+  return (raw ^ 0x80) >> 2;
+}
+#endif
+
+static posit8_t posit8_sigmoid(posit8_t a) {
+  if (a.value == 0x80) return a; // NaR
+#if ES8 == 0
+  return posit8_t((uint8_t) posit8SigmoidRaw(a.value));
+#else
+  return posit8_t((uint8_t) pgm_read_byte(&positSigmoid8Table[a.value]));
+#endif
+}
+
+static posit8_t posit8_tanh(posit8_t a) {
+  if (a.value == 0x80) return a; // NaR
+#if ES8 == 0
+  // tanh(x) = 2 * sigmoid(2x) - 1, 2x doubles the magnitude bits field by field
+  uint8_t magnitude = (a.value & 0x80) ? -a.value : a.value;
+  if (magnitude < 0x20) magnitude <<= 1; // below 1/2, fixed point
+  else if (magnitude < 0x40) magnitude += 0x20; // [1/2,1) to [1,2)
+  else magnitude = 0x40 | (magnitude >> 1); // one more regime bit, maxpos stays maxpos
+  uint8_t doubled = (a.value & 0x80) ? -magnitude : magnitude;
+  return posit8_t((uint8_t)(2 * posit8SigmoidRaw(doubled) - 64)); // in [-1,1), raw/64 again
+#else
+  return posit8_t((uint8_t) pgm_read_byte(&positTanh8Table[a.value]));
+#endif
+}
+
+// Fixed-point value of a table (2^32 is one) for a positive posit16 raw value, interpolated
+// linearly between points 128 raw values apart. Interpolating values rather than raw
+// values avoids steps where results change binade (1/4, 1/2 ...).
+static uint32_t posit16Interpolate(const uint32_t* table, uint16_t magnitude) {
+  uint8_t index = magnitude >> 7;
+  uint8_t fraction = (magnitude & 0x7F) << 1;
+  uint32_t low = pgm_read_dword(&table[index]);
+  uint32_t high = pgm_read_dword(&table[index + 1]);
+  if (high >= low) return low + ((high - low) >> 8) * fraction;
+  return low - ((low - high) >> 8) * fraction;
+}
+
+// Truncated posit of a fixed-point fraction (2^32 is one). Below one the regime is only
+// zeros and a one, so that fields are placed with shifts like in positRandom::uniformBody()
+static posit16_t posit16FromFraction(bool sign, uint32_t fraction) {
+  if (!fraction) return posit16_t((uint16_t)0);
+  uint8_t zeros = clz32(fraction);
+  int8_t powerof2 = -1 - zeros;
+  int8_t regime = powerof2 >> ES16; // -1 to -9
+  uint8_t exponent = powerof2 & ((1 << ES16) - 1);
+  uint32_t mantissa = (fraction << zeros) << 1; // eliminate leading one
+  uint16_t raw = ((1UL << (30 + regime)) // terminating one of the regime
+    | ((uint32_t) exponent << (30 + regime - ES16))
+    | ((mantissa >> (2 + ES16)) >> -regime)) >> 16;
+  return posit16_t((uint16_t)(sign ? -raw : raw));
+}
+
+// The table holds sigmoid(-x) for x >= 0, sigmoid(x) = 1 - sigmoid(-x) on the other side
+static posit16_t posit16_sigmoid(posit16_t a) {
+  if (a.value == 0x8000) return a; // NaR
+  bool negative = a.value & 0x8000;
+  uint32_t tail = posit16Interpolate(positSigmoid16Table, negative ? (uint16_t) -a.value : a.value);
+  if (negative) return posit16FromFraction(false, tail);
+  return posit16FromFraction(false, tail ? -tail : 0xFFFFFFFFUL);
+}
+
+// tanh is odd, the table holds tanh(x) for x >= 0
+static posit16_t posit16_tanh(posit16_t a) {
+  if (a.value == 0x8000) return a; // NaR
+  bool negative = a.value & 0x8000;
+  uint16_t magnitude = negative ? -a.value : a.value;
+  if (magnitude < 0x1800) { // below 2^-6, x^3/3 is less than one ulp of x : tanh(x) truncates to the next posit toward zero
+    if (magnitude) magnitude--; // tanh(0) = 0
+    return posit16_t((uint16_t)(negative ? -magnitude : magnitude));
+  }
+  return posit16FromFraction(negative, posit16Interpolate(positTanh16Table, magnitude));
+}
+
+// x * relu6(x + 3) / 6 : zero below -3, x itself above 3, in between with splitPosit
+// (exact x + 3 and product, one truncation)
+static splitPosit positHardSwish(splitPosit x) {
+  splitPosit sixth; // 1/6 rounded up, so that exact results are not truncated one ulp down
+  sixth.powerof2 = -3;
+  sixth.mantissa = 0xAAAAAAABUL;
+  return x * (x + 3) * sixth;
+}
+
+static posit8_t posit8_hard_swish(posit8_t a) {
+  if (a.value == 0x80) return a; // NaR
+  if ((int8_t) a.value <= (int8_t) -POSIT8_THREE.value) return posit8_t((uint8_t)0);
+  if ((int8_t) a.value >= (int8_t) POSIT8_THREE.value) return a;
+  return positHardSwish(a).pack8();
+}
+static posit16_t posit16_hard_swish(posit16_t a) {
+  if (a.value == 0x8000) return a; // NaR
+  if ((int16_t) a.value <= (int16_t) -POSIT16_THREE.value) return posit16_t((uint16_t)0);
+  if ((int16_t) a.value >= (int16_t) POSIT16_THREE.value) return a;
+  return positHardSwish(a).pack16();
+}
+
+// Bulk versions, out may be the same array as in
+static void posit8_relu(const posit8_t* in, posit8_t* out, uint16_t count) {
+  for (uint16_t i = 0; i < count; i++) out[i] = posit8_relu(in[i]);
+}
+static void posit16_relu(const posit16_t* in, posit16_t* out, uint16_t count) {
+  for (uint16_t i = 0; i < count; i++) out[i] = posit16_relu(in[i]);
+}
+static void posit8_sigmoid(const posit8_t* in, posit8_t* out, uint16_t count) {
+  for (uint16_t i = 0; i < count; i++) out[i] = posit8_sigmoid(in[i]);
+}
+static void posit16_sigmoid(const posit16_t* in, posit16_t* out, uint16_t count) {
+  for (uint16_t i = 0; i < count; i++) out[i] = posit16_sigmoid(in[i]);
+}
+static void posit8_tanh(const posit8_t* in, posit8_t* out, uint16_t count) {
+  for (uint16_t i = 0; i < count; i++) out[i] = posit8_tanh(in[i]);
+}
+static void posit16_tanh(const posit16_t* in, posit16_t* out, uint16_t count) {
+  for (uint16_t i = 0; i < count; i++) out[i] = posit16_tanh(in[i]);
+}
+static void posit8_hard_swish(const posit8_t* in, posit8_t* out, uint16_t count) {
+  for (uint16_t i = 0; i < count; i++) out[i] = posit8_hard_swish(in[i]);
+}
+static void posit16_hard_swish(const posit16_t* in, posit16_t* out, uint16_t count) {
+  for (uint16_t i = 0; i < count; i++) out[i] = posit16_hard_swish(in[i]);
+}
+
+#endif // POSIT_ACTIVATION_H
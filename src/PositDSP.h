@@ -0,0 +1,307 @@
+/*************************************************************************************
+
+PositDSP : FIR filter and FFT of posit16 signals for the Posit Library for Arduino
+
+  A filter written with posit operators, acc = acc + c[k] * x[n - k], truncates twice per
+  tap, and the errors of long filters add up. These kernels only truncate once per output :
+  - positAccumulator sums posit16 products exactly : 64-bit fixed point, whose binary
+    point moves up when a bigger term arrives (terms more than 2^28 times smaller than
+    the biggest one so far lose their lowest bits). pack16() gives the truncated sum.
+  - positFIR filters one sample or an array at a time, with posit16 coefficients and a
+    delay line provided by the caller
+  - posit16_fft() computes in place the FFT of n complex posit16 values (n = 4 to 1024,
+    power of 2), with radix-4 butterflies and a last radix-2 stage when log2(n) is odd.
+    Values are converted once to 32-bit fixed point with a common exponent (block
+    floating point), shifted right only when a stage could overflow, and packed once.
+    Twiddles are posit16 constants in flash (a quarter wave of sine, generated by
+    extras/host/TwiddleTable.cpp). The caller provides 2 * n int32_t of working memory
+    (8 * n bytes : n = 64 at most on an Uno).
+  extras/host/DSPBenchmark.cpp compares both with posit operators and with float.
+
+  Example (moving average of 4 samples) :
+    const posit16_t taps[4] = {0.25_p16, 0.25_p16, 0.25_p16, 0.25_p16};
+    posit16_t delay[4];
+    positFIR average(taps, delay, 4);
+    posit16_t smooth = average.filter(sample);
+
+  Copyright (c) 2024-2025 Christophe Vermeulen, MIT license (see Posit.h)
+************************************************************************************/
+
+#ifndef POSIT_DSP_H
+#define POSIT_DSP_H
+
+#include "Posit.h"
+
+// Generated by extras/host/TwiddleTable.cpp
+static const uint16_t positSine16Table[257] PROGMEM = { // sin(2 * pi * index / 1024)
+  0x0000, 0x1248, 0x1648, 0x18B6, 0x1A48, 0x1BDA, 0x1CB6, 0x1D7F,
+  0x1E48, 0x1F11, 0x1FD9, 0x20A2, 0x216B, 0x2233, 0x22FB, 0x23C4,
+  0x248C, 0x2554, 0x261C, 0x26E4, 0x27AB, 0x2839, 0x289D, 0x2901,
+  0x2964, 0x29C7, 0x2A2B, 0x2A8E, 0x2AF1, 0x2B54, 0x2BB7, 0x2C1A,
+  0x2C7C, 0x2CDF, 0x2D41, 0x2DA4, 0x2E06, 0x2E68, 0x2ECA, 0x2F2B,
+  0x2F8D, 0x2FEE, 0x3028, 0x3058, 0x3089, 0x30B9, 0x30EA, 0x311A,
+  0x314A, 0x317A, 0x31AA, 0x31DA, 0x320A, 0x3239, 0x3269, 0x3298,
+  0x32C8, 0x32F7, 0x3326, 0x3355, 0x3384, 0x33B3, 0x33E2, 0x3410,
+  0x343F, 0x346D, 0x349C, 0x34CA, 0x34F8, 0x3526, 0x3553, 0x3581,
+  0x35AF, 0x35DC, 0x3609, 0x3636, 0x3663, 0x3690, 0x36BD, 0x36E9,
+  0x3716, 0x3742, 0x376E, 0x379A, 0x37C6, 0x37F1, 0x380E, 0x3824,
+  0x383A, 0x384F, 0x3865, 0x387A, 0x388F, 0x38A5, 0x38BA, 0x38CF,
+  0x38E4, 0x38F8, 0x390D, 0x3922, 0x3937, 0x394B, 0x395F, 0x3974,
+  0x3988, 0x399C, 0x39B0, 0x39C4, 0x39D8, 0x39EC, 0x39FF, 0x3A13,
+  0x3A26, 0x3A3A, 0x3A4D, 0x3A60, 0x3A73, 0x3A86, 0x3A99, 0x3AAC,
+  0x3ABF, 0x3AD1, 0x3AE4, 0x3AF6, 0x3B08, 0x3B1B, 0x3B2D, 0x3B3E,
+  0x3B50, 0x3B62, 0x3B74, 0x3B85, 0x3B97, 0x3BA8, 0x3BB9, 0x3BCA,
+  0x3BDB, 0x3BEC, 0x3BFC, 0x3C0D, 0x3C1E, 0x3C2E, 0x3C3E, 0x3C4E,
+  0x3C5E, 0x3C6E, 0x3C7E, 0x3C8E, 0x3C9D, 0x3CAC, 0x3CBC, 0x3CCB,
+  0x3CDA, 0x3CE9, 0x3CF8, 0x3D06, 0x3D15, 0x3D23, 0x3D32, 0x3D40,
+  0x3D4E, 0x3D5C, 0x3D69, 0x3D77, 0x3D85, 0x3D92, 0x3D9F, 0x3DAC,
+  0x3DB9, 0x3DC6, 0x3DD3, 0x3DDF, 0x3DEC, 0x3DF8, 0x3E04, 0x3E10,
+  0x3E1C, 0x3E28, 0x3E34, 0x3E3F, 0x3E4B, 0x3E56, 0x3E61, 0x3E6C,
+  0x3E77, 0x3E81, 0x3E8C, 0x3E96, 0x3EA1, 0x3EAB, 0x3EB5, 0x3EBF,
+  0x3EC8, 0x3ED2, 0x3EDB, 0x3EE4, 0x3EEE, 0x3EF7, 0x3EFF, 0x3F08,
+  0x3F11, 0x3F19, 0x3F21, 0x3F29, 0x3F31, 0x3F39, 0x3F41, 0x3F48,
+  0x3F50, 0x3F57, 0x3F5E, 0x3F65, 0x3F6C, 0x3F72, 0x3F79, 0x3F7F,
+  0x3F85, 0x3F8B, 0x3F91, 0x3F97, 0x3F9C, 0x3FA2, 0x3FA7, 0x3FAC,
+  0x3FB1, 0x3FB6, 0x3FBB, 0x3FBF, 0x3FC4, 0x3FC8, 0x3FCC, 0x3FD0,
+  0x3FD4, 0x3FD7, 0x3FDB, 0x3FDE, 0x3FE1, 0x3FE4, 0x3FE7, 0x3FEA,
+  0x3FEC, 0x3FEF, 0x3FF1, 0x3FF3, 0x3FF5, 0x3FF7, 0x3FF8, 0x3FFA,
+  0x3FFB, 0x3FFC, 0x3FFD, 0x3FFE, 0x3FFF, 0x3FFF, 0x4000, 0x4000,
+  0x4000
+};
+
+struct positAccumulator {
+  int64_t sum; // value is sum * 2^lsb
+  int16_t lsb;
+  bool nar;
+
+  positAccumulator(): sum(0), lsb(0), nar(false) {}
+
+  void clear() {
+    sum = 0;
+    nar = false;
+  }
+
+  void add(posit16_t a, posit16_t b) { // += a * b, exact product
+    if (a.value == 0x8000 || b.value == 0x8000) nar = true;
+    if (nar || a.value == 0 || b.value == 0) return;
+    bool aSign, bSign;
+    int8_t aExponent, bExponent;
+    uint16_t aMantissa, bMantissa; // with leading one at bit15
+    posit16_t::positSplit(a, aSign, aExponent, aMantissa);
+    posit16_t::positSplit(b, bSign, bExponent, bMantissa);
+    addTerm(aSign != bSign, (uint32_t) aMantissa * bMantissa, aExponent + bExponent - 30);
+  }
+  void add(posit16_t a) {
+    if (a.value == 0x8000) nar = true;
+    if (nar || a.value == 0) return;
+    bool sign;
+    int8_t powerof2;
+    uint16_t mantissa;
+    posit16_t::positSplit(a, sign, powerof2, mantissa);
+    addTerm(sign, mantissa, powerof2 - 15);
+  }
+
+  // += magnitude * 2^powerof2, magnitude below 2^32
+  void addTerm(bool negative, uint32_t magnitude, int16_t powerof2) {
+    if (sum == 0) lsb = powerof2 - 28; // bit 31 of the term at bit 59, 28 bits below it
+    int16_t shift = powerof2 - lsb;
+    if (shift > 28) { // bigger term : move the binary point up
+      int16_t move = shift - 28;
+      sum = (move < 63) ? sum >> move : (sum < 0 ? -1 : 0);
+      lsb += move;
+      shift = 28;
+    }
+    int64_t term = (shift >= 0) ? (int64_t) magnitude << shift : (shift > -32 ? magnitude >> -shift : 0);
+    sum += negative ? -term : term;
+    if (sum >= (1LL << 61) || sum < -(1LL << 61)) { // keep a free bit above the biggest term
+      sum >>= 1;
+      lsb++;
+    }
+  }
+
+  posit16_t pack16() const { // truncated once
+    if (nar) return posit16_t((uint16_t) 0x8000);
+    splitPosit result;
+    if (sum == 0) return result.pack16();
+    result.sign = sum < 0;
+    uint64_t magnitude = result.sign ? -(uint64_t) sum : (uint64_t) sum;
+    uint8_t zeros = (magnitude >> 32) ? clz32(magnitude >> 32) : 32 + clz32(magnitude);
+    result.powerof2 = lsb + 63 - zeros;
+    result.mantissa = (magnitude << zeros) >> 32;
+    return result.pack16();
+  }
+}; // end of positAccumulator struct definition
+
+class positFIR {
+  public:
+  const posit16_t* coefficients; // coefficients[0] is applied to the newest sample
+  posit16_t* history; // the last taps samples, circular
+  uint8_t taps;
+  uint8_t newest; // position of the newest sample in history
+
+  positFIR(const posit16_t* c, posit16_t* h, uint8_t count): coefficients(c), history(h), taps(count), newest(0) {
+    for (uint8_t i = 0; i < taps; i++) history[i] = posit16_t((uint16_t)0);
+  }
+
+  posit16_t filter(posit16_t sample) {
+    newest = newest ? newest - 1 : taps - 1; // history runs backwards, like coefficients
+    history[newest] = sample;
+    positAccumulator sum;
+    const posit16_t* c = coefficients;
+    for (uint8_t i = newest; i < taps; i++) sum.add(*c++, history[i]);
+    for (uint8_t i = 0; i < newest; i++) sum.add(*c++, history[i]);
+    return sum.pack16();
+  }
+
+  void filter(const posit16_t* in, posit16_t* out, uint16_t count) { // out may be in
+    for (uint16_t i = 0; i < count; i++) out[i] = filter(in[i]);
+  }
+}; // end of positFIR class definition
+
+// Twiddle value in fixed point with 30 fraction bits
+static int32_t positTwiddleFixed(uint16_t index) {
+  uint16_t raw = pgm_read_word(&positSine16Table[index]);
+  if (raw == 0) return 0;
+  bool sign;
+  int8_t powerof2; // 0 or below, sines are at most one
+  uint16_t mantissa;
+  posit16_t::positSplit(posit16_t(raw), sign, powerof2, mantissa);
+  return (int32_t)(((uint32_t) mantissa << 15) >> -powerof2);
+}
+
+// cos and sin of 2 * pi * m / 1024, m = 0 to 1023, from the quarter wave
+static void positTwiddle(uint16_t m, int32_t& cosine, int32_t& sine) {
+  uint16_t angle = m & 0xFF;
+  int32_t c = positTwiddleFixed(256 - angle), s = positTwiddleFixed(angle);
+  switch (m >> 8) { // quadrant
+    case 0: cosine = c; sine = s; break;
+    case 1: cosine = -s; sine = c; break;
+    case 2: cosine = -c; sine = -s; break;
+    default: cosine = s; sine = -c;
+  }
+}
+
+static int32_t positMulFixed(int32_t a, int32_t twiddle) { // twiddle with 30 fraction bits
+  return ((int64_t) a * twiddle) >> 30;
+}
+
+// (re, im) *= cos(2 pi m / 1024) - i sin(2 pi m / 1024)
+static void positRotate(int32_t& re, int32_t& im, uint16_t m) {
+  if (m == 0) return;
+  int32_t cosine, sine;
+  positTwiddle(m, cosine, sine);
+  int32_t r = positMulFixed(re, cosine) + positMulFixed(im, sine);
+  im = positMulFixed(im, cosine) - positMulFixed(re, sine);
+  re = r;
+}
+
+// Shift values right so that they stay below 2^bits, returns the shift
+static uint8_t positHeadroom(int32_t* values, uint16_t count, uint8_t bits) {
+  uint32_t all = 0;
+  for (uint16_t i = 0; i < count; i++) all |= (values[i] < 0) ? ~(uint32_t) values[i] : (uint32_t) values[i];
+  uint8_t length = all ? 32 - clz32(all) : 0;
+  if (length <= bits) return 0;
+  uint8_t shift = length - bits;
+  for (uint16_t i = 0; i < count; i++) values[i] >>= shift;
+  return shift;
+}
+
+// In-place FFT of n complex values, n = 4 to 1024 (power of 2). work holds 2 * n int32_t.
+// Inverse FFT through conj(fft(conj(x))) / n. Results are truncated once, NaR anywhere
+// in the input gives NaR everywhere.
+static void posit16_fft(posit16_t* re, posit16_t* im, uint16_t n, int32_t* work, bool inverse = false) {
+  int32_t* wr = work;
+  int32_t* wi = work + n;
+  uint8_t bits = 0;
+  while ((1U << bits) < n) bits++;
+
+  // common exponent : the biggest 2's power of the inputs
+  int16_t top = -0x7FFF;
+  bool nar = false;
+  for (uint16_t i = 0; i < 2 * n; i++) {
+    posit16_t p = (i < n) ? re[i] : im[i - n];
+    if (p.value == 0x8000) nar = true;
+    if (p.value == 0 || p.value == 0x8000) continue;
+    bool sign;
+    int8_t powerof2;
+    uint16_t mantissa;
+    posit16_t::positSplit(p, sign, powerof2, mantissa);
+    if (powerof2 > top) top = powerof2;
+  }
+  if (nar) {
+    for (uint16_t i = 0; i < n; i++) re[i] = im[i] = posit16_t((uint16_t) 0x8000);
+    return;
+  }
+  if (top == -0x7FFF) return; // all zeros
+
+  int16_t lsb = top - 26; // 2's power of bit 0, inputs below 2^27
+  for (uint16_t i = 0; i < 2 * n; i++) {
+    posit16_t p = (i < n) ? re[i] : im[i - n];
+    int32_t fixed = 0;
+    if (p.value != 0) {
+      bool sign;
+      int8_t powerof2;
+      uint16_t mantissa;
+      posit16_t::positSplit(p, sign, powerof2, mantissa);
+      int8_t shift = powerof2 - top + 11;
+      uint32_t magnitude = (shift >= 0) ? (uint32_t) mantissa << shift : (shift > -16 ? mantissa >> -shift : 0);
+      fixed = (sign != (inverse && i >= n)) ? -(int32_t) magnitude : (int32_t) magnitude;
+    }
+    work[i] = fixed;
+  }
+
+  // decimation in frequency, radix-4 butterflies store their outputs in bit-reversed
+  // order (0, 2, 1, 3), so that the whole result is in bit-reversed order
+  uint16_t length = n;
+  for (; length >= 4; length >>= 2) {
+    lsb += positHeadroom(work, 2 * n, 27); // a radix-4 butterfly multiplies by 8 at most
+    uint16_t quarter = length >> 2, step = 1024 / length;
+    for (uint16_t start = 0; start < n; start += length) {
+      for (uint16_t k = 0; k < quarter; k++) {
+        uint16_t i0 = start + k, i1 = i0 + quarter, i2 = i1 + quarter, i3 = i2 + quarter;
+        int32_t ar = wr[i0] + wr[i2], ai = wi[i0] + wi[i2]; // a = x0 + x2
+        int32_t br = wr[i0] - wr[i2], bi = wi[i0] - wi[i2]; // b = x0 - x2
+        int32_t cr = wr[i1] + wr[i3], ci = wi[i1] + wi[i3]; // c = x1 + x3
+        int32_t dr = wr[i1] - wr[i3], di = wi[i1] - wi[i3]; // d = x1 - x3
+        wr[i0] = ar + cr; wi[i0] = ai + ci;
+        wr[i1] = ar - cr; wi[i1] = ai - ci;
+        positRotate(wr[i1], wi[i1], 2 * k * step);
+        wr[i2] = br + di; wi[i2] = bi - dr; // b - i d
+        positRotate(wr[i2], wi[i2], k * step);
+        wr[i3] = br - di; wi[i3] = bi + dr; // b + i d
+        positRotate(wr[i3], wi[i3], 3 * k * step);
+      }
+    }
+  }
+  if (length == 2) {
+    lsb += positHeadroom(work, 2 * n, 29);
+    for (uint16_t i = 0; i < n; i += 2) {
+      int32_t r = wr[i] - wr[i + 1], s = wi[i] - wi[i + 1];
+      wr[i] += wr[i + 1]; wi[i] += wi[i + 1];
+      wr[i + 1] = r; wi[i + 1] = s;
+    }
+  }
+  if (inverse) lsb -= bits; // divide by n
+
+  splitPosit result;
+  for (uint16_t i = 0; i < n; i++) {
+    uint16_t j = 0; // bit-reversed index
+    for (uint8_t b = 0; b < bits; b++) j |= ((i >> b) & 1) << (bits - 1 - b);
+    for (uint8_t part = 0; part < 2; part++) {
+      int32_t fixed = part ? wi[j] : wr[j];
+      if (part && inverse) fixed = -fixed;
+      if (fixed == 0) {
+        (part ? im[i] : re[i]) = posit16_t((uint16_t)0);
+        continue;
+      }
+      result.sign = fixed < 0;
+      uint32_t magnitude = result.sign ? -(uint32_t) fixed : (uint32_t) fixed;
+      uint8_t zeros = clz32(magnitude);
+      result.powerof2 = lsb + 31 - zeros;
+      result.mantissa = magnitude << zeros;
+      (part ? im[i] : re[i]) = result.pack16();
+    }
+  }
+}
+
+#endif // POSIT_DSP_H
@@ -0,0 +1,148 @@
+/*************************************************************************************
+
+PositExpr : fused evaluation of posit expressions for the Posit Library for Arduino
+
+  Each posit operator splits both operands, computes, packs the result and truncates
+  it : a formula like (a/3)*(3-a*a/2) packs and splits every temporary again, and
+  the truncation errors add up. Wrapping an operand with posit_fused() makes the
+  operators build an expression tree instead (plain structs, resolved by the compiler),
+  which is only evaluated when assigned to a posit16_t or posit8_t :
+  - operands are split once into splitPosit (sign, power of two, 32-bit mantissa)
+  - all operations stay unpacked, with more than twice the posit16 precision
+  - the result is packed and truncated once, like a single posit operation
+
+  Operands can be posit16_t, posit8_t, splitPosit or int (exact, so 3 or 2 cost no
+  conversion). eval() gives the unpacked result, to keep working on it with splitPosit.
+  Nothing changes for code that does not call posit_fused(), this header is opt-in.
+
+  Only operators with a fused operand are deferred : each operator only sees its own
+  operands, so in posit_fused(q8) + alpha * (reward + gamma * next - q8) just the first
+  + is fused, the product and the parenthesized group still round at every step.
+  Start every subexpression with a fused operand.
+
+  Example :
+    posit16_t x = ...;
+    posit16_t s = posit_fused(x) / 3 * (3 - posit_fused(x) * x / 2); // sin(x), one rounding
+    posit8_t q = posit_fused(q8) + posit_fused(alpha) * (posit_fused(reward)
+                 + posit_fused(gamma) * next - q8); // TD update, one rounding
+
+  Assign with = (or call to16()/to8()) : posit16_t s(expression) is ambiguous, since
+  the expression converts to both posit types. Expressions hold copies of their
+  operands, so they can be kept in an auto variable and evaluated later.
+
+  Copyright (c) 2024-2025 Christophe Vermeulen, MIT license (see Posit.h)
+************************************************************************************/
+
+#ifndef POSIT_EXPR_H
+#define POSIT_EXPR_H
+
+#include "Posit.h"
+
+// Expression tree : leaves hold a posit or int, nodes hold two subexpressions and the
+// operator as template parameter, so that eval() is resolved by the compiler.
+template <typename T> struct positLeaf {
+  T value;
+  splitPosit eval() const {
+    return splitPosit(value);
+  }
+  posit16_t to16() const {
+    return eval().pack16();
+  }
+  posit8_t to8() const {
+    return eval().pack8();
+  }
+  operator posit16_t() const {
+    return to16();
+  }
+  operator posit8_t() const {
+    return to8();
+  }
+};
+
+template <char OP, typename L, typename R> struct positNode {
+  L left;
+  R right;
+  splitPosit eval() const {
+    splitPosit a = left.eval(), b = right.eval();
+    if (OP == '+') return splitPosit::add(a, b);
+    if (OP == '-') return splitPosit::add(a, -b);
+    if (OP == '*') return splitPosit::mul(a, b);
+    return splitPosit::div(a, b);
+  }
+  posit16_t to16() const {
+    return eval().pack16();
+  }
+  posit8_t to8() const {
+    return eval().pack8();
+  }
+  operator posit16_t() const {
+    return to16();
+  }
+  operator posit8_t() const {
+    return to8();
+  }
+};
+
+// Start of a fused expression
+template <typename T> positLeaf<T> posit_fused(const T& value) {
+  positLeaf<T> leaf = {value};
+  return leaf;
+}
+
+// Operand types accepted by the operators : fused ones, or posits and ints made leaves
+template <typename T> struct positOperand {
+  static const bool valid = false;
+  static const bool fused = false;
+};
+template <typename T> struct positOperand<positLeaf<T> > {
+  static const bool valid = true;
+  static const bool fused = true;
+  typedef positLeaf<T> type;
+  static type make(const positLeaf<T>& e) { return e; }
+};
+template <char OP, typename L, typename R> struct positOperand<positNode<OP, L, R> > {
+  static const bool valid = true;
+  static const bool fused = true;
+  typedef positNode<OP, L, R> type;
+  static type make(const positNode<OP, L, R>& e) { return e; }
+};
+template <typename T> struct positPlainOperand {
+  static const bool valid = true;
+  static const bool fused = false;
+  typedef positLeaf<T> type;
+  static type make(const T& v) { return posit_fused(v); }
+};
+template <> struct positOperand<posit16_t> : positPlainOperand<posit16_t> {};
+template <> struct positOperand<posit8_t> : positPlainOperand<posit8_t> {};
+template <> struct positOperand<int> : positPlainOperand<int> {};
+template <> struct positOperand<splitPosit> : positPlainOperand<splitPosit> {};
+
+// Node type, only defined if both operands are valid and one at least is fused,
+// so that the posit16_t and posit8_t class operators are not affected
+template <char OP, typename L, typename R, bool OK = positOperand<L>::valid && positOperand<R>::valid
+          && (positOperand<L>::fused || positOperand<R>::fused)> struct positFusedNode {};
+template <char OP, typename L, typename R> struct positFusedNode<OP, L, R, true> {
+  typedef positNode<OP, typename positOperand<L>::type, typename positOperand<R>::type> type;
+  static type make(const L& l, const R& r) {
+    type node = {positOperand<L>::make(l), positOperand<R>::make(r)};
+    return node;
+  }
+};
+
+template <typename L, typename R> typename positFusedNode<'+', L, R>::type operator + (const L& l, const R& r) {
+  return positFusedNode<'+', L, R>::make(l, r);
+}
+template <typename L, typename R> typename positFusedNode<'-', L, R>::type operator - (const L& l, const R& r) {
+  return positFusedNode<'-', L, R>::make(l, r);
+}
+template <typename L, typename R> typename positFusedNode<'*', L, R>::type operator * (const L& l, const R& r) {
+  return positFusedNode<'*', L, R>::make(l, r);
+}
+template <typename L, typename R> typename positFusedNode<'/', L, R>::type operator / (const L& l, const R& r) {
+  return positFusedNode<'/', L, R>::make(l, r);
+}
+template <typename E> typename positFusedNode<'-', int, E>::type operator - (const E& e) { // 0 - e, exact
+  return positFusedNode<'-', int, E>::make(0, e);
+}
+
+#endif // POSIT_EXPR_H
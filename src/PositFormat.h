@@ -0,0 +1,433 @@
+/*************************************************************************************
+
+PositFormat : decimal formatting and parsing for the Posit Library for Arduino
+
+  Converts posit8_t and posit16_t to and from decimal text without any float,
+  working directly on the split sign, power of two and mantissa with integer
+  arithmetic. No memory allocation, the caller provides the char buffers.
+
+  - posit_to_chars writes the shortest decimal string that posit_from_chars reads
+    back to the very same posit (shortest round-trip), for example 0.1 or 3.1416
+  - posit_from_chars parses [+-]digits[.digits][e[+-]digits] or NaR, and rounds
+    towards zero like the other posit constructors (EPSILON is not applied)
+  - posit_to_line and posit_from_line handle arrays as separated values (CSV)
+
+  Like std::to_chars, no terminating zero is written : the returned pointer
+  marks the end of the text, or is NULL if the buffer was too small.
+
+  Example :
+    char buffer[POSIT_CHARS_MAX];
+    char* end = posit_to_chars(buffer, buffer + sizeof(buffer), myPosit);
+    Serial.write(buffer, end - buffer);
+
+  Copyright (c) 2024-2025 Christophe Vermeulen, MIT license (see Posit.h)
+************************************************************************************/
+
+#ifndef POSIT_FORMAT_H
+#define POSIT_FORMAT_H
+
+#include "Posit.h"
+
+#define POSIT_CHARS_MAX 16 // enough for any posit16_t, like -0.000012345 or -1.2345e-17
+#define POSIT_DIGITS 8 // digits compared for shortest output, posit16 never needs more than 6
+
+// Divides a number stored as little-endian 16-bit words by divisor, in place, and
+// returns the remainder. Only 32-bit divisions : a 64-bit one would pull the libgcc
+// 64-bit division (__udivdi3) into AVR builds
+static uint16_t positDivide(uint16_t* words, uint8_t count, uint16_t divisor) {
+  uint32_t remainder = 0;
+  while (count--) {
+    uint32_t part = (remainder << 16) | words[count];
+    words[count] = part / divisor;
+    remainder = part % divisor;
+  }
+  return remainder;
+}
+
+// Decimal digits of mantissa*2^powerof2 starting at weight 10^top, using
+// exact 64-bit integer and fixed point arithmetic (needs powerof2 >= -60)
+// Returns true if nonzero digits remain after the last one written
+static bool positDigits(uint32_t mantissa, int8_t powerof2, int8_t top, uint8_t* digits, uint8_t count) {
+  uint64_t intPart, fracPart = 0;
+  uint8_t fracBits = 0;
+  uint8_t intDigits[18]; // 2^58 has 18 digits
+  uint8_t intCount = 0;
+  uint8_t i = 0;
+  bool sticky = false;
+
+  if (powerof2 >= 0) {
+    intPart = (uint64_t) mantissa << powerof2;
+  } else {
+    fracBits = -powerof2;
+    intPart = (uint64_t) mantissa >> fracBits;
+    fracPart = (uint64_t) mantissa & (((uint64_t) 1 << fracBits) - 1);
+  }
+  // least significant digit first
+  if (intPart >> 32) { // up to 2^58, divided as 16-bit words while above 32 bits
+    uint16_t words[4] = {(uint16_t) intPart, (uint16_t)(intPart >> 16), (uint16_t)(intPart >> 32), (uint16_t)(intPart >> 48)};
+    while (words[3] || words[2]) intDigits[intCount++] = positDivide(words, 4, 10);
+    intPart = ((uint32_t) words[1] << 16) | words[0];
+  }
+  for (uint32_t shortPart = intPart; shortPart; shortPart /= 10) intDigits[intCount++] = shortPart % 10;
+
+  // integer digits, padded with leading zeros above the number
+  int8_t weight = top;
+  for (; i < count && weight >= 0; i++, weight--) {
+    digits[i] = weight < intCount ? intDigits[weight] : 0;
+  }
+  for (; weight >= 0; weight--) { // integer digits not written
+    if (weight < intCount && intDigits[weight]) sticky = true;
+  }
+
+  // fraction digits, multiplying by 10 moves the next digit above fracBits
+  uint64_t fracMask = ((uint64_t) 1 << fracBits) - 1;
+  for (weight = -1; weight > top; weight--) { // leading zeros before top
+    fracPart = (fracPart << 3) + (fracPart << 1);
+    fracPart &= fracMask;
+  }
+  for (; i < count; i++) {
+    fracPart = (fracPart << 3) + (fracPart << 1);
+    digits[i] = fracPart >> fracBits;
+    fracPart &= fracMask;
+  }
+  return sticky || fracPart;
+}
+
+// Weight (power of 10) of the leading digit of mantissa*2^powerof2
+static int8_t positDecimalExponent(uint32_t mantissa, int8_t powerof2) {
+  int8_t top = 0;
+
+  if (powerof2 >= 0 || ((uint64_t) mantissa >> -powerof2)) { // 1 or more, count integer digits
+    uint64_t intPart = powerof2 >= 0 ? (uint64_t) mantissa << powerof2 : (uint64_t) mantissa >> -powerof2;
+    // compare with growing powers of 10 rather than dividing, up to 10^18 above 2^58
+    for (uint64_t power = 10; power <= intPart; power = (power << 3) + (power << 1)) top++;
+  } else { // below 1, count leading zeros of fraction
+    uint8_t fracBits = -powerof2;
+    uint64_t fracPart = mantissa;
+    do {
+      fracPart = (fracPart << 3) + (fracPart << 1);
+      top--;
+    } while (!(fracPart >> fracBits));
+  }
+  return top;
+}
+
+// Positive posit16_t as odd mantissa and power of two (value = mantissa*2^powerof2)
+static void positExact(posit16_t p, uint32_t& mantissa, int8_t& powerof2) {
+  bool sign;
+  uint16_t mantissa16;
+
+  posit16_t::positSplit(p, sign, powerof2, mantissa16);
+  powerof2 -= 15; // leading one at bit 15
+  while (!(mantissa16 & 1)) { // remove trailing zeros, keeps powerof2 >= -60
+    mantissa16 >>= 1;
+    powerof2++;
+  }
+  mantissa = mantissa16;
+}
+
+// Shortest decimal text for positive posit lo, read back as lo if below hi.
+// hi is the next posit, or NaR if lo is maxpos (then 2*lo is used instead)
+static char* positChars(char* first, char* last, posit16_t lo, posit16_t hi) {
+  uint32_t loMantissa, hiMantissa;
+  int8_t loExponent, hiExponent;
+  uint8_t loDigits[POSIT_DIGITS], hiDigits[POSIT_DIGITS], outDigits[POSIT_DIGITS + 1];
+
+  positExact(lo, loMantissa, loExponent);
+  if (hi.value == 0x8000) {
+    hiMantissa = loMantissa;
+    hiExponent = loExponent + 1;
+  } else positExact(hi, hiMantissa, hiExponent);
+  // common power of two for both
+  if (loExponent > hiExponent) {
+    loMantissa <<= loExponent - hiExponent;
+    loExponent = hiExponent;
+  } else {
+    hiMantissa <<= hiExponent - loExponent;
+  }
+
+  int8_t top = positDecimalExponent(hiMantissa, loExponent);
+  bool loSticky = positDigits(loMantissa, loExponent, top, loDigits, POSIT_DIGITS);
+  bool hiSticky = positDigits(hiMantissa, loExponent, top, hiDigits, POSIT_DIGITS);
+
+  // Find the smallest count of digits rounding lo upwards to a value below hi
+  uint8_t count;
+  for (count = 1; count <= POSIT_DIGITS; count++) {
+    bool roundUp = loSticky;
+    for (uint8_t i = count; i < POSIT_DIGITS; i++) if (loDigits[i]) roundUp = true;
+    for (uint8_t i = 0; i < count; i++) outDigits[i + 1] = loDigits[i];
+    outDigits[0] = 0; // room for carry
+    if (roundUp) {
+      uint8_t i = count;
+      while (++outDigits[i] == 10) outDigits[i--] = 0;
+    }
+    if (outDigits[0]) continue; // carried to 10^(top+1), too big
+
+    int8_t compare = 0; // compare with hi, digit by digit
+    for (uint8_t i = 0; i < count && !compare; i++) {
+      if (outDigits[i + 1] != hiDigits[i]) compare = outDigits[i + 1] < hiDigits[i] ? -1 : 1;
+    }
+    if (!compare) { // equal so far, smaller only if hi has more nonzero digits
+      compare = hiSticky ? -1 : 0;
+      for (uint8_t i = count; i < POSIT_DIGITS; i++) if (hiDigits[i]) compare = -1;
+    }
+    if (compare < 0) break;
+  }
+  if (count > POSIT_DIGITS) { // never happens for posit16, keep truncated lo
+    count = POSIT_DIGITS;
+    for (uint8_t i = 0; i < count; i++) outDigits[i + 1] = loDigits[i];
+  }
+
+  // remove leading and trailing zeros
+  uint8_t* digits = outDigits + 1;
+  while (count > 1 && digits[0] == 0) {
+    digits++;
+    count--;
+    top--;
+  }
+  while (count > 1 && digits[count - 1] == 0) count--;
+
+  // write as 123.45 or 0.0012345, or 1.2345e-17 for very big or small numbers
+  bool scientific = (top < -5 || top > 5);
+  uint8_t length;
+  if (scientific) length = count + (count > 1) + 2 + (top < 0) + (top <= -10 || top >= 10);
+  else if (top >= 0) length = (count > top + 1) ? count + 1 : top + 1;
+  else length = 1 - top + count; // 0.000ddd
+  if (last - first < length) return NULL;
+
+  if (scientific) {
+    *first++ = '0' + digits[0];
+    if (count > 1) *first++ = '.';
+    for (uint8_t i = 1; i < count; i++) *first++ = '0' + digits[i];
+    *first++ = 'e';
+    if (top < 0) {
+      *first++ = '-';
+      top = -top;
+    }
+    if (top >= 10) *first++ = '0' + top / 10;
+    *first++ = '0' + top % 10;
+  } else if (top >= 0) {
+    for (uint8_t i = 0; i <= top; i++) *first++ = '0' + (i < count ? digits[i] : 0);
+    if (count > top + 1) *first++ = '.';
+    for (uint8_t i = top + 1; i < count; i++) *first++ = '0' + digits[i];
+  } else {
+    *first++ = '0';
+    *first++ = '.';
+    for (int8_t i = -1; i > top; i--) *first++ = '0';
+    for (uint8_t i = 0; i < count; i++) *first++ = '0' + digits[i];
+  }
+  return first;
+}
+
+static char* posit_to_chars(char* first, char* last, posit16_t p) {
+  const char nar[] = "NaR";
+
+  if (p.value == 0 || p.value == 0x8000) {
+    if (last - first < (p.value ? 3 : 1)) return NULL;
+    if (!p.value) *first++ = '0';
+    else for (uint8_t i = 0; i < 3; i++) *first++ = nar[i];
+    return first;
+  }
+  if (p.value & 0x8000) {
+    if (first == last) return NULL;
+    *first++ = '-';
+    p.value = -p.value;
+  }
+  return positChars(first, last, p, posit16_t((uint16_t)(p.value + 1)));
+}
+
+static char* posit_to_chars(char* first, char* last, posit8_t p) {
+  if (p.value == 0 || p.value == 0x80) return posit_to_chars(first, last, posit16_t(p));
+  if (p.value & 0x80) {
+    if (first == last) return NULL;
+    *first++ = '-';
+    p.value = -p.value;
+  }
+  posit8_t next((uint8_t)(p.value + 1)); // NaR after maxpos
+  return positChars(first, last, posit16_t(p), posit16_t(next));
+}
+
+// Parse decimal text as posit16_t parts (sign, 2's power, mantissa without leading 1)
+// Returns the end of the number, or first if no number was found (p unchanged)
+// Result : 0 for zero, 1 for NaR, 2 for a number in parts
+static const char* positParse(const char* first, const char* last, uint8_t& result,
+                              bool& sign, int8_t& powerof2, uint16_t& mantissa) {
+  const char* in = first;
+  uint64_t decimal = 0; // up to 19 significant digits
+  int16_t exponent10 = 0;
+  bool digitFound = false;
+
+  sign = false;
+  if (in != last && (*in == '-' || *in == '+')) sign = (*in++ == '-');
+  if (last - in >= 3 && (in[0] | 0x20) == 'n' && (in[1] | 0x20) == 'a'
+      && ((in[2] | 0x20) == 'r' || (in[2] | 0x20) == 'n')) { // NaR or NaN
+    result = 1;
+    return in + 3;
+  }
+  for (bool point = false; in != last; in++) {
+    if (*in == '.' && !point) {
+      point = true;
+      continue;
+    }
+    if (*in < '0' || *in > '9') break;
+    digitFound = true;
+    if (decimal < 1000000000000000000ULL) { // room for one more digit
+      decimal = decimal * 10 + (*in - '0');
+      if (point) exponent10--;
+    } else if (!point) exponent10++; // dropped digit, number stays truncated
+  }
+  if (!digitFound) return first;
+  if (in != last && (*in | 0x20) == 'e') { // exponent, only if followed by digits
+    const char* exponentStart = in++;
+    bool negative = false;
+    int16_t value = 0;
+    if (in != last && (*in == '-' || *in == '+')) negative = (*in++ == '-');
+    if (in == last || *in < '0' || *in > '9') in = exponentStart;
+    else {
+      while (in != last && *in >= '0' && *in <= '9') {
+        if (value < 1000) value = value * 10 + (*in - '0');
+        in++;
+      }
+      exponent10 += negative ? -value : value;
+    }
+  }
+
+  result = 0;
+  if (decimal == 0) return in;
+  result = 2;
+  if (exponent10 > 60) exponent10 = 60; // far above maxpos, still saturates
+  if (exponent10 < -80) exponent10 = -80; // far below minpos, still saturates
+  // value = decimal * 10^exponent10, truncated to 64 bits with leading one at bit 63
+  int16_t power = 0;
+  if (exponent10 >= 0) {
+    while (exponent10-- > 0) {
+      if (decimal > 0xFFFFFFFFFFFFFFFFULL / 10) { // above 2^60, far beyond maxpos
+        decimal = 0xFFFFFFFFFFFFFFFFULL;
+        break;
+      }
+      decimal *= 10;
+    }
+  } else {
+    // floor(decimal * 2^shift / 5^n) * 2^(-shift-n), with a small multi-word integer
+    // since floor(floor(x/a)/b) is floor(x/(a*b)), divisions by parts of 5^n are exact.
+    // 16-bit words and divisors keep every division within 32 bits
+    uint8_t n = -exponent10;
+    uint8_t bits = 64;
+    while (!(decimal >> 63)) {
+      decimal <<= 1;
+      bits--;
+    }
+    int16_t shift = 42 - bits + ((n * 2378) >> 10); // 2378/1024 > log2(5), about 42-bit quotient
+    uint16_t words[16] = {0}; // little-endian, decimal shifted left by 64-bits+shift
+    // place normalized decimal (top bit 63) so that it is worth decimal * 2^(shift - 64 + bits)
+    int16_t position = shift - 64 + bits; // bit position of decimal's bit 0 in words
+    if (position < 0) { // right shift first, exact with floor
+      decimal >>= -position;
+      position = 0;
+    }
+    for (uint8_t i = 0; i < 64; i++) {
+      if (decimal & ((uint64_t) 1 << i)) words[(position + i) >> 4] |= (uint16_t) 1 << ((position + i) & 15);
+    }
+    while (n) {
+      uint8_t step = n > 6 ? 6 : n; // 5^6 fits in 16 bits
+      uint16_t divisor = 1;
+      for (uint8_t i = 0; i < step; i++) divisor *= 5;
+      positDivide(words, 16, divisor);
+      n -= step;
+    }
+    decimal = 0; // quotient fits in 64 bits
+    for (int8_t i = 3; i >= 0; i--) decimal = (decimal << 16) | words[i];
+    power = exponent10 - shift; // 2^-n from 10^-n, and 2^-shift
+  }
+  int8_t leading = 63;
+  while (!(decimal >> leading)) leading--;
+  power += leading;
+  if (power > 100) power = 100; // constructors saturate to maxpos or minpos
+  if (power < -100) power = -100;
+  powerof2 = power;
+  mantissa = (decimal << (63 - leading)) >> 47; // 16 bits after leading one
+  return in;
+}
+
+static const char* posit_from_chars(const char* first, const char* last, posit16_t& p) {
+  uint8_t result;
+  bool sign;
+  int8_t powerof2;
+  uint16_t mantissa;
+
+  const char* end = positParse(first, last, result, sign, powerof2, mantissa);
+  if (end == first) return first;
+  if (result == 2) p = posit16_t(sign, powerof2, mantissa);
+  else p.value = result ? 0x8000 : 0;
+  return end;
+}
+
+static const char* posit_from_chars(const char* first, const char* last, posit8_t& p) {
+  uint8_t result;
+  bool sign;
+  int8_t powerof2;
+  uint16_t mantissa;
+
+  const char* end = positParse(first, last, result, sign, powerof2, mantissa);
+  if (end == first) return first;
+  if (result == 2) {
+    uint8_t mantissa8 = mantissa >> 8;
+    p = posit8_t(sign, powerof2, mantissa8);
+  } else p.value = result ? 0x80 : 0;
+  return end;
+}
+
+// Bulk formatting : count values separated by separator, ending with a newline
+static char* posit_to_line(char* first, char* last, const posit16_t* values, uint16_t count, char separator = ',') {
+  for (uint16_t i = 0; i < count && first; i++) {
+    if (i) {
+      if (first == last) return NULL;
+      *first++ = separator;
+    }
+    first = posit_to_chars(first, last, values[i]);
+  }
+  if (!first || first == last) return NULL;
+  *first++ = '\n';
+  return first;
+}
+
+static char* posit_to_line(char* first, char* last, const posit8_t* values, uint16_t count, char separator = ',') {
+  for (uint16_t i = 0; i < count && first; i++) {
+    if (i) {
+      if (first == last) return NULL;
+      *first++ = separator;
+    }
+    first = posit_to_chars(first, last, values[i]);
+  }
+  if (!first || first == last) return NULL;
+  *first++ = '\n';
+  return first;
+}
+
+// Bulk parsing : reads up to count values separated by spaces, tabs, commas or semicolons
+// Stops at end of line or at the first unreadable value, returns the number of values read
+static uint16_t posit_from_line(const char* first, const char* last, posit16_t* values, uint16_t count) {
+  uint16_t read = 0;
+  while (read < count) {
+    while (first != last && (*first == ' ' || *first == '\t' || *first == ',' || *first == ';')) first++;
+    const char* end = posit_from_chars(first, last, values[read]);
+    if (end == first) break;
+    first = end;
+    read++;
+  }
+  return read;
+}
+
+static uint16_t posit_from_line(const char* first, const char* last, posit8_t* values, uint16_t count) {
+  uint16_t read = 0;
+  while (read < count) {
+    while (first != last && (*first == ' ' || *first == '\t' || *first == ',' || *first == ';')) first++;
+    const char* end = posit_from_chars(first, last, values[read]);
+    if (end == first) break;
+    first = end;
+    read++;
+  }
+  return read;
+}
+
+#endif // POSIT_FORMAT_H
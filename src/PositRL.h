@@ -0,0 +1,144 @@
+/*************************************************************************************
+
+PositRL : temporal difference updates of posit tables for the Posit Library for Arduino
+
+  Tabular reinforcement learning (TD(0), SARSA, Q-learning) spends its time in one line :
+    Q[s][a] += alpha * (reward + gamma * Q[s'][a'] - Q[s][a]);
+  With posits, that line truncates three or four times, and the indexes are often
+  computed through floats. positTD works on contiguous tables, indexed by integers :
+  - Q-tables hold Q[state * actions + action], value tables (TD(0)) hold V[state]
+  - the update is computed with splitPosit (32-bit mantissas) and truncated only once,
+    when the new value is packed into the table
+  - greedy() picks the best action of a state by comparing raw values as integers,
+    posits being ordered like 2's complement numbers (NaR is below everything)
+  - batch updates from a replay buffer : the transitions (up to 32 at a time) that
+    update the same table entry are applied to its unpacked value, which is packed once.
+    Entries are processed in the order of their first transition, targets read the
+    table as it is at that time (a batch of distinct entries gives the same results
+    as updating one transition at a time).
+  Tables may be posit8_t (1 byte per value, fits an Uno) or posit16_t.
+  extras/host/PositRLThreads.h has a multithreaded version for offline training on a PC.
+
+  Example (SARSA, 21 x 21 states and 3 actions) :
+    posit8_t Q[21 * 21 * 3];
+    positTD td(0.1_p16, 0.9_p16, 3); // alpha, gamma, actions per state
+    positTransition t = {state, action, nextAction, nextState, reward, false};
+    td.sarsa(Q, t);
+    nextAction = td.greedy(Q, nextState);
+
+  Copyright (c) 2024-2025 Christophe Vermeulen, MIT license (see Posit.h)
+************************************************************************************/
+
+#ifndef POSIT_RL_H
+#define POSIT_RL_H
+
+#include "Posit.h"
+
+// One step of experience : action taken in state, reward received, nextState reached.
+// nextAction is only used by SARSA, terminal transitions have no next state value.
+struct positTransition {
+  uint16_t state;
+  uint8_t action;
+  uint8_t nextAction;
+  uint16_t nextState;
+  posit16_t reward; // posit8_t rewards convert exactly
+  bool terminal;
+};
+
+// Raw values in posit order and packing, same code for both table types
+static inline int16_t positOrder(posit8_t p) {
+  return (int8_t) p.value;
+}
+static inline int16_t positOrder(posit16_t p) {
+  return (int16_t) p.value;
+}
+static inline void positStore(posit8_t& p, const splitPosit& value) {
+  p = value.pack8();
+}
+static inline void positStore(posit16_t& p, const splitPosit& value) {
+  p = value.pack16();
+}
+
+class positTD {
+  public:
+  enum { TD0, SARSA, Q_LEARNING }; // update rules
+  splitPosit alpha; // learning rate
+  splitPosit gamma; // discount factor
+  uint8_t actions; // values per state in Q-tables
+
+  positTD(posit16_t learningRate, posit16_t discount, uint8_t actionCount = 1):
+    alpha(learningRate), gamma(discount), actions(actionCount) {}
+
+  // Best action of a state, the first one if several are equal
+  template <typename P> uint8_t greedy(const P* q, uint16_t state) const {
+    const P* row = q + (uint32_t) state * actions;
+    uint8_t best = 0;
+    for (uint8_t a = 1; a < actions; a++) {
+      if (positOrder(row[a]) > positOrder(row[best])) best = a;
+    }
+    return best;
+  }
+
+  // V[s] += alpha * (reward + gamma * V[s'] - V[s]), on a table of state values
+  template <typename P> void td0(P* v, const positTransition& t) const {
+    update(v, &t, 1, TD0);
+  }
+  // Q[s][a] += alpha * (reward + gamma * Q[s'][a'] - Q[s][a])
+  template <typename P> void sarsa(P* q, const positTransition& t) const {
+    update(q, &t, 1, SARSA);
+  }
+  // Q[s][a] += alpha * (reward + gamma * max(Q[s']) - Q[s][a])
+  template <typename P> void qLearning(P* q, const positTransition& t) const {
+    update(q, &t, 1, Q_LEARNING);
+  }
+
+  // Replay buffer versions, one truncation per updated entry
+  template <typename P> void td0(P* v, const positTransition* batch, uint16_t count) const {
+    update(v, batch, count, TD0);
+  }
+  template <typename P> void sarsa(P* q, const positTransition* batch, uint16_t count) const {
+    update(q, batch, count, SARSA);
+  }
+  template <typename P> void qLearning(P* q, const positTransition* batch, uint16_t count) const {
+    update(q, batch, count, Q_LEARNING);
+  }
+
+  // Table entry updated by a transition
+  uint32_t entry(const positTransition& t, uint8_t rule) const {
+    if (rule == TD0) return t.state;
+    return (uint32_t) t.state * actions + t.action;
+  }
+
+  // reward + gamma * value of the next state, not truncated
+  template <typename P> splitPosit target(const P* q, const positTransition& t, uint8_t rule) const {
+    splitPosit reward = t.reward;
+    if (t.terminal) return reward;
+    P next;
+    if (rule == TD0) next = q[t.nextState];
+    else if (rule == SARSA) next = q[(uint32_t) t.nextState * actions + t.nextAction];
+    else next = q[(uint32_t) t.nextState * actions + greedy(q, t.nextState)];
+    return reward + gamma * next;
+  }
+
+  // Transitions are grouped by entry, 32 transitions at a time (one bit each in done)
+  template <typename P> void update(P* q, const positTransition* batch, uint16_t count, uint8_t rule) const {
+    for (uint16_t start = 0; start < count; start += 32) {
+      const positTransition* group = batch + start;
+      uint8_t size = (count - start < 32) ? count - start : 32;
+      uint32_t done = 0; // transitions already applied
+      for (uint8_t i = 0; i < size; i++) {
+        if (done & (1UL << i)) continue;
+        uint32_t index = entry(group[i], rule);
+        splitPosit value = q[index];
+        for (uint8_t j = i; j < size; j++) {
+          if (entry(group[j], rule) != index) continue;
+          value += alpha * (target(q, group[j], rule) - value);
+          done |= 1UL << j;
+        }
+        positStore(q[index], value);
+      }
+    }
+  }
+}; // end of positTD class definition
+
+#endif // POSIT_RL_H
@@ -0,0 +1,91 @@
+/*************************************************************************************
+
+PositRandom : random posits and biased coins for the Posit Library for Arduino
+
+  Epsilon-greedy and stochastic policies compare a random number with a probability :
+  random(100) < epsilon * 100 costs a float conversion and a float product per step.
+  positRandom draws posits directly from random bits instead :
+  - xorshift32 generator, 4 bytes of state, only shifts and xors
+  - uniform16() and uniform8() give the posit truncation of a uniform number in [0,1) :
+    each posit p comes out with probability next(p) - p, small values being finer
+    grained like the posit format itself. The power of two is the count of leading
+    zero bits (geometric distribution), the mantissa comes from other random bits, and
+    the bit pattern is assembled directly (no regime loop, no parts constructor).
+  - bernoulli(p) is true with probability p exactly, for posits in [0,1] : truncation
+    keeps the order, so trunc(u) < p exactly when u < p, and posits compare like
+    integers. No conversion at all, p >= 1 is always true, p <= 0 or NaR never.
+  - fill() writes arrays of uniform posits (weight initialization, exploration noise)
+  EPSILON is not applied : numbers below minpos come out as zero, like in operations.
+
+  Example (epsilon-greedy) :
+    positRandom rng(analogRead(0));
+    if (rng.bernoulli(epsilon)) action = rng.next() % ACTIONS; // explore
+    else action = greedyAction(state);
+
+  Copyright (c) 2024-2025 Christophe Vermeulen, MIT license (see Posit.h)
+************************************************************************************/
+
+#ifndef POSIT_RANDOM_H
+#define POSIT_RANDOM_H
+
+#include "Posit.h"
+
+class positRandom {
+  public:
+  uint32_t state; // never zero
+
+  positRandom(uint32_t seed = 2463534242UL): state(seed ? seed : 2463534242UL) {}
+
+  uint32_t next() { // xorshift32, period 2^32-1
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+  }
+
+  posit16_t uniform16() {
+    return posit16_t((uint16_t)(uniformBody(ES16, -14) >> 16)); // regime -14 is minpos
+  }
+  posit8_t uniform8() {
+    return posit8_t((uint8_t)(uniformBody(ES8, -6) >> 24));
+  }
+
+  bool bernoulli(posit16_t p) { // true with probability p
+    return (int16_t) uniform16().value < (int16_t) p.value;
+  }
+  bool bernoulli(posit8_t p) {
+    return (int8_t) uniform8().value < (int8_t) p.value;
+  }
+
+  void fill(posit16_t* out, uint16_t count) {
+    for (uint16_t i = 0; i < count; i++) out[i] = uniform16();
+  }
+  void fill(posit8_t* out, uint16_t count) {
+    for (uint16_t i = 0; i < count; i++) out[i] = uniform8();
+  }
+
+  // Posit bits of a uniform number in [0,1), left-aligned in 32 bits below the sign bit.
+  // Regime, exponent and mantissa fields are placed with shifts, the lower bits that
+  // don't fit in the posit are dropped by the caller (truncation).
+  uint32_t uniformBody(uint8_t es, int8_t minRegime) {
+    uint32_t bits = next();
+    uint16_t mantissa = bits; // lower half for the mantissa ...
+    uint16_t leading = bits >> 16; // ... upper half for the power of two
+    int16_t powerof2 = -1;
+    while (!leading) { // 1 in 65536, leading zeros continue in the next draw
+      powerof2 -= 16;
+      if (powerof2 < minRegime * (1 << es)) return 0; // below minpos
+      leading = next() >> 16;
+    }
+    powerof2 -= clz16(leading);
+
+    int8_t regime = powerof2 >> es; // floor, negative below one
+    if (regime < minRegime) return 0;
+    uint8_t exponent = powerof2 & ((1 << es) - 1);
+    return (1UL << (30 + regime)) // terminating one of the regime, zeros above it
+      | ((uint32_t) exponent << (30 + regime - es))
+      | (((uint32_t) mantissa << (14 - es)) >> -regime); // below the exponent field
+  }
+}; // end of positRandom class definition
+
+#endif // POSIT_RANDOM_H
@@ -0,0 +1,277 @@
+/*************************************************************************************
+
+PositStream : compact serialization of sparse posit arrays for the Posit Library
+
+  Q-tables and weight arrays are mostly zeros (unvisited states), and neighbouring
+  values are close to each other. Since posit bit patterns are ordered like 2's
+  complement integers, close values have close raw values, so small differences
+  of raw values (deltas) are enough to code them.
+
+  Stream format, one token per byte (plus one or two data bytes for some) :
+    0x00-0x7F          run of 1 to 128 zeros
+    0x80-0xBF          delta -32..31 from previous nonzero raw value
+    0xC0-0xDF + 1 byte delta -4096..4095 (posit16_t, posit8_t uses literals instead)
+    0xE0-0xEF + 1 byte run of 129 to 4224 zeros
+    0xF0 + raw value   literal, one byte for posit8_t, two bytes (msb first) for posit16_t
+    0xFF               end of stream, deltas restart from zero
+  The stream does not store the posit size : decode with the type that was encoded.
+
+  Encoder and decoder only keep a few bytes of state, so they work through small
+  fixed buffers (or byte per byte) between Serial, EEPROM or flash and the table.
+  The encoder never writes more than POSIT_STREAM_MAX bytes per value.
+
+  Example (EEPROM snapshot of a posit8_t table) :
+    positStreamEncoder encoder;
+    uint8_t bytes[POSIT_STREAM_MAX];
+    for (uint16_t i = 0; i < TABLE_SIZE; i++) {
+      uint8_t count = encoder.put(table[i], bytes);
+      for (uint8_t j = 0; j < count; j++) EEPROM.update(address++, bytes[j]);
+    }
+    ... same with encoder.end(bytes) to finish the stream
+
+  Copyright (c) 2024-2025 Christophe Vermeulen, MIT license (see Posit.h)
+************************************************************************************/
+
+#ifndef POSIT_STREAM_H
+#define POSIT_STREAM_H
+
+#include "Posit.h"
+
+#define POSIT_STREAM_MAX 5 // longest output of put() : zero run (2 bytes) and literal (3 bytes)
+#define POSIT_STREAM_RUN 4224 // longest zero run in one token
+#define POSIT_STREAM_END 0xFF
+
+class positStreamEncoder {
+  public:
+  uint16_t previous; // last nonzero raw value
+  uint16_t zeroRun; // zeros not written yet
+  uint16_t consumed; // values used by the last encode() call
+
+  positStreamEncoder(): previous(0), zeroRun(0), consumed(0) {}
+
+  // Encode one value, writes 0 to POSIT_STREAM_MAX bytes in out and returns their count
+  uint8_t put(posit8_t p, uint8_t* out) {
+    return putRaw(p.value, 1, out);
+  }
+  uint8_t put(posit16_t p, uint8_t* out) {
+    return putRaw(p.value, 2, out);
+  }
+
+  // Write pending zeros and the end of stream token (at most 3 bytes)
+  uint8_t end(uint8_t* out) {
+    uint8_t length = flushRun(out);
+    out[length++] = POSIT_STREAM_END;
+    previous = 0;
+    return length;
+  }
+
+  // Encode values while there is room in out, returns bytes written (see consumed)
+  uint16_t encode(const posit8_t* values, uint16_t count, uint8_t* out, uint16_t outCount) {
+    uint16_t length = 0;
+    for (consumed = 0; consumed < count && outCount - length >= POSIT_STREAM_MAX; consumed++) {
+      length += putRaw(values[consumed].value, 1, out + length);
+    }
+    return length;
+  }
+  uint16_t encode(const posit16_t* values, uint16_t count, uint8_t* out, uint16_t outCount) {
+    uint16_t length = 0;
+    for (consumed = 0; consumed < count && outCount - length >= POSIT_STREAM_MAX; consumed++) {
+      length += putRaw(values[consumed].value, 2, out + length);
+    }
+    return length;
+  }
+
+  uint8_t flushRun(uint8_t* out) {
+    if (zeroRun == 0) return 0;
+    uint16_t run = zeroRun;
+    zeroRun = 0;
+    if (run <= 128) {
+      out[0] = run - 1;
+      return 1;
+    }
+    run -= 129;
+    out[0] = 0xE0 | (run >> 8);
+    out[1] = run;
+    return 2;
+  }
+
+  uint8_t putRaw(uint16_t value, uint8_t size, uint8_t* out) {
+    if (value == 0) { // zeros are only counted
+      if (++zeroRun == POSIT_STREAM_RUN) return flushRun(out);
+      return 0;
+    }
+    uint8_t length = flushRun(out);
+    int16_t delta = value - previous;
+    if (size == 1) delta = (int8_t) delta; // posit8_t differences wrap around at 8 bits
+    if (delta >= -32 && delta <= 31) {
+      out[length++] = 0x80 | (delta + 32);
+    } else if (size == 2 && delta >= -4096 && delta <= 4095) {
+      delta += 4096;
+      out[length++] = 0xC0 | (delta >> 8);
+      out[length++] = delta;
+    } else {
+      out[length++] = 0xF0;
+      if (size == 2) out[length++] = value >> 8;
+      out[length++] = value;
+    }
+    previous = value;
+    return length;
+  }
+}; // end of positStreamEncoder class definition
+
+class positStreamDecoder {
+  public:
+  uint16_t previous; // last nonzero raw value
+  uint16_t zeroRun; // zeros decoded but not written yet
+  uint16_t data; // data bytes of current token
+  uint16_t consumed; // input bytes used by the last decode() call
+  uint8_t token; // current token, if partial
+  uint8_t missing; // data bytes still expected for current token
+  bool partial; // token split over two input buffers
+  bool ended; // end of stream token found
+
+  positStreamDecoder() {
+    reset();
+  }
+
+  void reset() {
+    previous = zeroRun = data = consumed = 0;
+    token = missing = 0;
+    partial = ended = false;
+  }
+
+  // Decode from in until input is used or out is full, returns values written.
+  // consumed tells how many bytes were used, the rest must be given again.
+  uint16_t decode(const uint8_t* in, uint16_t inCount, posit8_t* out, uint16_t outCount) {
+    const uint8_t* inNext = in;
+    uint16_t value, count = 0;
+    while (count < outCount && nextRaw(inNext, in + inCount, value, 1)) out[count++].value = value;
+    endOfStream(inNext, in + inCount);
+    consumed = inNext - in;
+    return count;
+  }
+  uint16_t decode(const uint8_t* in, uint16_t inCount, posit16_t* out, uint16_t outCount) {
+    const uint8_t* inNext = in;
+    uint16_t value, count = 0;
+    while (count < outCount && nextRaw(inNext, in + inCount, value, 2)) out[count++].value = value;
+    endOfStream(inNext, in + inCount);
+    consumed = inNext - in;
+    return count;
+  }
+
+  // Consume the end of stream token right after the last value, even if out is full
+  void endOfStream(const uint8_t*& in, const uint8_t* inEnd) {
+    if (!zeroRun && !partial && in != inEnd && *in == POSIT_STREAM_END) {
+      in++;
+      ended = true;
+      previous = 0;
+    }
+  }
+
+  // Next raw value, false if more input is needed or the stream ended
+  bool nextRaw(const uint8_t*& in, const uint8_t* inEnd, uint16_t& value, uint8_t size) {
+    while (!zeroRun) {
+      if (ended) return false;
+      if (!partial) { // start a new token
+        if (in == inEnd) return false;
+        token = *in++;
+        data = 0;
+        partial = true;
+        missing = (token >= 0xC0 && token < 0xF0) ? 1 : (token == 0xF0 ? size : 0);
+      }
+      while (missing) {
+        if (in == inEnd) return false;
+        data = (data << 8) | *in++;
+        missing--;
+      }
+      partial = false;
+      if (token < 0x80) zeroRun = token + 1;
+      else if (token < 0xC0) {
+        previous += (token & 0x3F) - 32;
+        value = previous;
+        return true;
+      } else if (token < 0xE0) {
+        previous += (((token & 0x1F) << 8) | data) - 4096;
+        value = previous;
+        return true;
+      } else if (token < 0xF0) zeroRun = (((token & 0x0F) << 8) | data) + 129;
+      else if (token == 0xF0) {
+        previous = data;
+        value = previous;
+        return true;
+      } else { // end of stream (other tokens are reserved)
+        ended = true;
+        previous = 0;
+      }
+    }
+    zeroRun--;
+    value = 0;
+    return true;
+  }
+}; // end of positStreamDecoder class definition
+
+// One-shot decoding of a complete stream in memory, for host side tools where the
+// whole buffer is available : no per byte state, zero runs are filled in place
+// Returns the count of values written, stops at end of stream or when out is full
+static uint32_t posit_stream_decode(const uint8_t* in, uint32_t inCount, posit16_t* out, uint32_t outCount) {
+  const uint8_t* inEnd = in + inCount;
+  uint16_t previous = 0;
+  uint32_t count = 0;
+
+  while (in < inEnd && count < outCount) {
+    uint8_t token = *in++;
+    uint32_t run = 0;
+    if (token < 0x80) run = token + 1;
+    else if (token < 0xC0) {
+      previous += (token & 0x3F) - 32;
+      out[count++].value = previous;
+    } else if (token < 0xF0) {
+      if (in == inEnd) break;
+      uint16_t data = ((token & 0x1F) << 8) | *in++;
+      if (token < 0xE0) out[count++].value = previous += data - 4096;
+      else run = (data & 0x0FFF) + 129;
+    } else if (token == 0xF0) {
+      if (inEnd - in < 2) break;
+      previous = (in[0] << 8) | in[1];
+      in += 2;
+      out[count++].value = previous;
+    } else break; // end of stream
+    if (run) {
+      if (run > outCount - count) run = outCount - count;
+      while (run--) out[count++].value = 0;
+    }
+  }
+  return count;
+}
+
+static uint32_t posit_stream_decode(const uint8_t* in, uint32_t inCount, posit8_t* out, uint32_t outCount) {
+  const uint8_t* inEnd = in + inCount;
+  uint8_t previous = 0;
+  uint32_t count = 0;
+
+  while (in < inEnd && count < outCount) {
+    uint8_t token = *in++;
+    uint32_t run = 0;
+    if (token < 0x80) run = token + 1;
+    else if (token < 0xC0) {
+      previous += (token & 0x3F) - 32;
+      out[count++].value = previous;
+    } else if (token < 0xF0) {
+      if (in == inEnd) break;
+      uint16_t data = ((token & 0x1F) << 8) | *in++;
+      if (token < 0xE0) out[count++].value = previous += data - 4096;
+      else run = (data & 0x0FFF) + 129;
+    } else if (token == 0xF0) {
+      if (in == inEnd) break;
+      previous = *in++;
+      out[count++].value = previous;
+    } else break; // end of stream
+    if (run) {
+      if (run > outCount - count) run = outCount - count;
+      while (run--) out[count++].value = 0;
+    }
+  }
+  return count;
+}
+
+#endif // POSIT_STREAM_H